@@ -0,0 +1,107 @@
+#include "bench.hpp"
+
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#ifdef __linux__
+#   include <cstring>
+#   include <linux/perf_event.h>
+#   include <sys/ioctl.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#endif
+
+#include "bbb/view_system/components/view.hpp"
+
+namespace {
+    using namespace bbb::vs;
+    
+    // hardware cache misses of this process, by perf_event_open.
+    // not available on other platforms or if perf events aren't permitted (e.g. perf_event_paranoid, containers).
+    struct cache_miss_counter {
+#ifdef __linux__
+        cache_miss_counter() {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+        ~cache_miss_counter() { if(isAvailable()) close(fd); };
+        
+        inline bool isAvailable() const { return 0 <= fd; };
+        inline void start() {
+            if(!isAvailable()) return;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+        inline long long stop() {
+            if(!isAvailable()) return -1;
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            long long count = 0;
+            if(read(fd, &count, sizeof(count)) != sizeof(count)) return -1;
+            return count;
+        }
+    private:
+        int fd{-1};
+#else
+        inline bool isAvailable() const { return false; };
+        inline void start() {};
+        inline long long stop() { return -1; };
+#endif
+    };
+    
+    // screen of n small views in a grid. if noise is given, other allocations are made between views,
+    // like views created over time in an app.
+    view::ref buildScreen(int n, std::vector<void *> *noise) {
+        auto root = view::create(0, 0, 1000, 1000);
+        for(int i = 0; i < n; ++i) {
+            root->add(view::create(i % 100 * 10.0f, i / 100 % 100 * 10.0f, 8, 8));
+            if(noise) noise->push_back(std::malloc(64 + std::rand() % 512));
+        }
+        return root;
+    }
+};
+
+// create / destroy churn of a screen of 100k views, and traversal of a screen built among other allocations.
+// traversal is draw after moving root, which recomputes global origin of all views.
+BBB_BENCH(arena_churn_and_traversal) {
+    const int n = 100000;
+    const ofRectangle visible(0, 0, 1000, 1000);
+    cache_miss_counter counter;
+    for(int useArena = 0; useArena < 2; ++useArena) {
+        const double churn = bbb::bench::measure([&] {
+            std::unique_ptr<scoped_arena> scope(useArena ? new scoped_arena(arena::create(256)) : nullptr);
+            auto root = buildScreen(n, nullptr);
+        }, 3);
+        
+        std::vector<void *> noise;
+        std::unique_ptr<scoped_arena> scope(useArena ? new scoped_arena(arena::create(256)) : nullptr);
+        auto root = buildScreen(n, &noise);
+        scope.reset();
+        
+        float x = 0.0f;
+        auto traverse = [&] {
+            root->setPosition(x = 1.0f - x, 0.0f);
+            root->draw(visible);
+        };
+        const double traversal = bbb::bench::measure(traverse);
+        counter.start();
+        for(int i = 0; i < 10; ++i) traverse();
+        const long long misses = counter.stop();
+        
+        std::printf("  %s\n", useArena ? "arena" : "heap");
+        bbb::bench::report("create and destroy 100k views", churn);
+        bbb::bench::report("draw traversal", traversal);
+        if(0 <= misses) bbb::bench::report("cache misses per draw traversal", misses / 10.0, "misses");
+        else std::printf("  %-52s %12s\n", "cache misses per draw traversal", "n/a");
+        
+        root.reset();
+        for(auto p : noise) std::free(p);
+    }
+}
@@ -0,0 +1,83 @@
+//
+//  bench.hpp
+//
+//  Created by ISHII 2bit on 2018/03/25.
+//
+
+#pragma once
+
+#ifndef bbb_view_system_bench_hpp
+#define bbb_view_system_bench_hpp
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace bbb {
+    namespace bench {
+        struct entry {
+            const char *name;
+            void (*run)();
+        };
+        
+        inline std::vector<entry> &entries() {
+            static std::vector<entry> _;
+            return _;
+        }
+        
+        struct registration {
+            registration(const char *name, void (*run)()) { entries().push_back({name, run}); };
+        };
+        
+        // defined in allocation_counter.cpp. counts operator new of whole program.
+        std::size_t numAllocations();
+        
+        // milliseconds per call of body, best of rounds to reduce noise
+        template <typename function_t>
+        double measure(function_t body, int repeat = 10, int rounds = 3) {
+            double best = 0.0;
+            for(int r = 0; r < rounds; ++r) {
+                const auto start = std::chrono::steady_clock::now();
+                for(int i = 0; i < repeat; ++i) body();
+                const double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeat;
+                if(r == 0 || elapsed < best) best = elapsed;
+            }
+            return best;
+        }
+        
+        inline void report(const char *label, double ms) {
+            std::printf("  %-52s %12.4f ms\n", label, ms);
+        }
+        inline void report(const char *label, double value, const char *unit) {
+            std::printf("  %-52s %12.4f %s\n", label, value, unit);
+        }
+        
+        inline volatile double &sink() {
+            static volatile double _;
+            return _;
+        }
+        
+        // keeps results alive against optimizer
+        inline void consume(double value) {
+            sink() = value;
+        }
+        
+        // runs benchmarks whose name contains filter, or all if filter is null
+        inline void run(const char *filter) {
+            for(auto &&e : entries()) {
+                if(filter && !std::strstr(e.name, filter)) continue;
+                std::printf("[%s]\n", e.name);
+                e.run();
+            }
+        }
+    };
+};
+
+#define BBB_BENCH(name) \
+    static void name(); \
+    static bbb::bench::registration name##_registration(#name, name); \
+    static void name()
+
+#endif /* bbb_view_system_bench_hpp */
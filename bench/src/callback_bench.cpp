@@ -0,0 +1,80 @@
+#include "bench.hpp"
+
+#include <functional>
+#include <vector>
+
+#include "bbb/view_system/components/view.hpp"
+
+namespace {
+    using namespace bbb::vs;
+    using old_callback_t = std::function<void(mouse_event_arg)>;
+    
+    // same as opt_arg_function::convert before: callback without argument is wrapped by second std::function
+    old_callback_t adaptLikeBefore(std::function<void()> f) {
+        return [f](mouse_event_arg) { f(); };
+    }
+    
+    template <typename callback_t>
+    double measureCalls(std::vector<callback_t> &callbacks, const mouse_event_arg &arg) {
+        return bbb::bench::measure([&] {
+            for(auto &&c : callbacks) c(arg);
+        }, 100);
+    }
+};
+
+// calling 1000 callbacks, by std::function like before and by opt_arg_function.
+// callbacks capture two pointers, typical for [this, other] or [&a, &b].
+BBB_BENCH(callback_call_and_size) {
+    const int n = 1000;
+    int counter = 0;
+    int *pc = &counter;
+    float value = 0.0f;
+    float *pv = &value;
+    const mouse_event_arg arg(nullptr, ofPoint(1, 2), true);
+    
+    std::vector<old_callback_t> oldFull, oldAdapted;
+    std::vector<click_down_callback_t> newFull, newAdapted;
+    for(auto *c : {&oldFull, &oldAdapted}) c->reserve(n);
+    for(auto *c : {&newFull, &newAdapted}) c->reserve(n);
+    const std::size_t beforeOld = bbb::bench::numAllocations();
+    for(int i = 0; i < n; ++i) {
+        oldFull.push_back([pc, pv](mouse_event_arg arg) { *pc += arg.isInside; *pv += arg.p.x; });
+        oldAdapted.push_back(adaptLikeBefore([pc, pv] { ++*pc; *pv += 1.0f; }));
+    }
+    const std::size_t beforeNew = bbb::bench::numAllocations();
+    for(int i = 0; i < n; ++i) {
+        newFull.push_back([pc, pv](mouse_event_arg arg) { *pc += arg.isInside; *pv += arg.p.x; });
+        newAdapted.push_back([pc, pv] { ++*pc; *pv += 1.0f; });
+    }
+    const std::size_t afterNew = bbb::bench::numAllocations();
+    
+    std::printf("  %d callbacks per call\n", n);
+    bbb::bench::report("std::function: full arguments", measureCalls(oldFull, arg) * 1.0e6 / n, "ns");
+    bbb::bench::report("std::function: adapted (no argument)", measureCalls(oldAdapted, arg) * 1.0e6 / n, "ns");
+    bbb::bench::report("opt_arg_function: full arguments", measureCalls(newFull, arg) * 1.0e6 / n, "ns");
+    bbb::bench::report("opt_arg_function: adapted (no argument)", measureCalls(newAdapted, arg) * 1.0e6 / n, "ns");
+    bbb::bench::consume(counter + value);
+    
+    std::printf("  size\n");
+    bbb::bench::report("std::function: allocations per 2 callbacks", static_cast<double>(beforeNew - beforeOld) / n, "allocs");
+    bbb::bench::report("opt_arg_function: allocations per 2 callbacks", static_cast<double>(afterNew - beforeNew) / n, "allocs");
+    bbb::bench::report("sizeof std::function<void(mouse_event_arg)>", sizeof(old_callback_t), "bytes");
+    bbb::bench::report("sizeof opt_arg_function<void(mouse_event_arg)>", sizeof(click_down_callback_t), "bytes");
+    bbb::bench::report("sizeof view", sizeof(view), "bytes");
+    
+    // view with 5 capturing callbacks, like example's buttons
+    std::vector<view::ref> views;
+    views.reserve(n);
+    const std::size_t beforeViews = bbb::bench::numAllocations();
+    for(int i = 0; i < n; ++i) {
+        auto v = view::create(0, 0, 10, 10);
+        view *raw = v.get();
+        v->onClickDown([raw, pc] { ++*pc; });
+        v->onClickUp([raw, pc] { ++*pc; });
+        v->onMouseOver([raw, pc](mouse_event_arg arg) { *pc += arg.isInside; });
+        v->onDrag([raw, pc] { ++*pc; });
+        v->onWindowResized([raw](resized_event_arg arg) { raw->setSize(arg.rect.width, raw->getHeight()); });
+        views.push_back(v);
+    }
+    bbb::bench::report("allocations per view with 5 callbacks", static_cast<double>(bbb::bench::numAllocations() - beforeViews) / n, "allocs");
+}
@@ -0,0 +1,111 @@
+#include "bench.hpp"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "bbb/view_system/easing_table.hpp"
+
+namespace {
+    namespace easing = bbb::easing;
+    
+    typedef void (*array_function)(const float *, float *, std::size_t);
+    
+    // same as array version without SIMD, but scalar function can be inlined into the loop
+    template <float (*f)(float)>
+    void scalarLoop(const float *in, float *out, std::size_t n) {
+        for(std::size_t i = 0; i < n; ++i) out[i] = f(in[i]);
+    }
+    
+    struct easing_entry {
+        const char *name;
+        array_function array;
+        array_function scalar;
+    };
+    
+    const char *simdName() {
+#if defined(BBB_EASING_AVX)
+        return "AVX";
+#elif defined(BBB_EASING_SSE)
+        return "SSE";
+#elif defined(BBB_EASING_NEON)
+        return "NEON";
+#else
+        return "none";
+#endif
+    }
+    
+    // progress values in [0, 1], as given by many tweens
+    std::vector<float> progresses(std::size_t n) {
+        std::vector<float> t(n);
+        for(std::size_t i = 0; i < n; ++i) t[i] = (i * 7919 % n) / static_cast<float>(n - 1);
+        return t;
+    }
+};
+
+// array versions of easing vs loop of scalar versions, per value.
+// SIMD paths are chosen at compile time. build with -DBBB_EASING_NO_SIMD to see array versions without them.
+BBB_BENCH(easing_array_vs_scalar) {
+    const easing_entry entries[] = {
+        {"quadratic in_out", easing::quadratic::in_out, scalarLoop<easing::quadratic::in_out>},
+        {"cubic in_out", easing::cubic::in_out, scalarLoop<easing::cubic::in_out>},
+        {"quintic in_out", easing::quintic::in_out, scalarLoop<easing::quintic::in_out>},
+        {"circular in_out", easing::circular::in_out, scalarLoop<easing::circular::in_out>},
+    };
+    std::printf("  SIMD: %s\n", simdName());
+    for(std::size_t n : {1000, 10000, 100000}) {
+        const std::vector<float> t = progresses(n);
+        std::vector<float> result(n);
+        const int repeat = static_cast<int>(10000000 / n);
+        std::printf("  %d values, per value\n", static_cast<int>(n));
+        for(auto &&e : entries) {
+            const double array = bbb::bench::measure([&] {
+                e.array(t.data(), result.data(), n);
+                bbb::bench::consume(result[n / 2]);
+            }, repeat);
+            const double scalar = bbb::bench::measure([&] {
+                e.scalar(t.data(), result.data(), n);
+                bbb::bench::consume(result[n / 2]);
+            }, repeat);
+            const std::string label = e.name;
+            bbb::bench::report((label + ", array").c_str(), array * 1.0e6 / n, "ns");
+            bbb::bench::report((label + ", scalar loop").c_str(), scalar * 1.0e6 / n, "ns");
+        }
+    }
+}
+
+// lookup table vs direct evaluation of curves calling cos / pow / sqrt, and of cubic-bezier solved per value.
+// tables have default resolution (256 samples).
+BBB_BENCH(easing_table_vs_direct) {
+    const std::size_t n = 10000;
+    const std::vector<float> t = progresses(n);
+    std::vector<float> result(n);
+    auto &&run = [&](const char *name, const std::function<void()> &direct, const easing::table &lut) {
+        const double directTime = bbb::bench::measure([&] {
+            direct();
+            bbb::bench::consume(result[n / 2]);
+        }, 1000);
+        const double tableTime = bbb::bench::measure([&] {
+            lut(t.data(), result.data(), n);
+            bbb::bench::consume(result[n / 2]);
+        }, 1000);
+        const std::string label = name;
+        bbb::bench::report((label + ", direct").c_str(), directTime * 1.0e6 / n, "ns");
+        bbb::bench::report((label + ", table").c_str(), tableTime * 1.0e6 / n, "ns");
+    };
+    
+    std::printf("  %d values, per value\n", static_cast<int>(n));
+    run("sine in_out", [&] { scalarLoop<easing::sine::in_out>(t.data(), result.data(), n); },
+        easing::table::of(easing::type::sine_in_out));
+    run("exponential in_out", [&] { scalarLoop<easing::exponential::in_out>(t.data(), result.data(), n); },
+        easing::table::of(easing::type::exponential_in_out));
+    run("circular in_out", [&] { scalarLoop<easing::circular::in_out>(t.data(), result.data(), n); },
+        easing::table::of(easing::type::circular_in_out));
+    run("circular in_out, array version", [&] { easing::circular::in_out(t.data(), result.data(), t.size()); },
+        easing::table::of(easing::type::circular_in_out));
+    
+    // css ease
+    const easing::cubic_bezier ease(0.25f, 0.1f, 0.25f, 1.0f);
+    run("cubic_bezier(0.25, 0.1, 0.25, 1)", [&] { for(std::size_t i = 0; i < n; ++i) result[i] = ease(t[i]); },
+        easing::table(ease));
+}
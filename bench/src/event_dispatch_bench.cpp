@@ -0,0 +1,97 @@
+#include "bench.hpp"
+
+#include <vector>
+
+#include "bbb/view_system/components/view.hpp"
+
+// mouse over / down + up on 100 nested event transparent views, all of them under pointer and having callbacks.
+// before, each callback took shared_from_this of its view, copied it into hit list and into event arg by value.
+// baseline repeats those copies over same views, to show what is saved per event.
+// a small view out of the chain is moved per event, like a tween, and shouldn't make over hit-test again.
+BBB_BENCH(event_dispatch_hovered_views) {
+    using namespace bbb::vs;
+    auto &&router = event_router::get();
+    const int depth = 100;
+    auto root = view::create(0, 0, 800, 800);
+    std::vector<view *> chain;
+    int numCalls = 0;
+    view::ref parent = root;
+    for(int i = 0; i < depth; ++i) {
+        auto v = view::create(1, 1, 700, 700);
+        v->setEventTransparentness(true);
+        v->onMouseOver([&numCalls] { ++numCalls; });
+        v->onClickDown([&numCalls] { ++numCalls; });
+        v->onClickUp([&numCalls] { ++numCalls; });
+        parent->add(v);
+        chain.push_back(v.get());
+        parent = v;
+    }
+    auto far = view::create(760, 760, 30, 30);
+    root->add(far);
+    root->registerEvents();
+    
+    const int numEvents = 1000;
+    float x = 200.0f;
+    // first events grow buffers of router
+    router.dispatchMouse(mouse_event_type::over, {x, 200.0f});
+    router.dispatchMouse(mouse_event_type::down, {200.0f, 200.0f});
+    router.dispatchMouse(mouse_event_type::up, {200.0f, 200.0f});
+    
+    numCalls = 0;
+    std::size_t allocations = bbb::bench::numAllocations();
+    for(int i = 0; i < numEvents; ++i) router.dispatchMouse(mouse_event_type::over, {x += (i % 2 ? 1.0f : -1.0f), 200.0f});
+    const double overAllocations = static_cast<double>(bbb::bench::numAllocations() - allocations) / numEvents;
+    const double overCalls = static_cast<double>(numCalls) / numEvents;
+    
+    numCalls = 0;
+    allocations = bbb::bench::numAllocations();
+    for(int i = 0; i < numEvents; ++i) {
+        router.dispatchMouse(mouse_event_type::down, {200.0f, 200.0f});
+        router.dispatchMouse(mouse_event_type::up, {200.0f, 200.0f});
+    }
+    const double downUpAllocations = static_cast<double>(bbb::bench::numAllocations() - allocations) / numEvents;
+    const double downUpCalls = static_cast<double>(numCalls) / numEvents;
+    
+    const double over = bbb::bench::measure([&] {
+        for(int i = 0; i < numEvents; ++i) router.dispatchMouse(mouse_event_type::over, {x += (i % 2 ? 1.0f : -1.0f), 200.0f});
+    });
+    float y = 760.0f;
+    const double overMoving = bbb::bench::measure([&] {
+        for(int i = 0; i < numEvents; ++i) {
+            far->setPosition(760.0f, y = 1521.0f - y);
+            router.dispatchMouse(mouse_event_type::over, {x += (i % 2 ? 1.0f : -1.0f), 200.0f});
+        }
+    });
+    const double downUp = bbb::bench::measure([&] {
+        for(int i = 0; i < numEvents; ++i) {
+            router.dispatchMouse(mouse_event_type::down, {200.0f, 200.0f});
+            router.dispatchMouse(mouse_event_type::up, {200.0f, 200.0f});
+        }
+    });
+    
+    // shared_ptr copies per callback as before: shared_from_this into hit list, and copy into event arg
+    std::vector<view::ref> refs;
+    refs.reserve(depth);
+    const double baseline = bbb::bench::measure([&] {
+        for(int i = 0; i < numEvents; ++i) {
+            refs.clear();
+            for(auto &&v : chain) refs.push_back(v->shared_from_this());
+            for(auto &&r : refs) {
+                view::ref arg = r;
+                bbb::bench::consume(arg->getAlpha());
+            }
+        }
+    });
+    
+    std::printf("  %d nested hovered views\n", depth);
+    bbb::bench::report("over: callbacks per event", overCalls, "calls");
+    bbb::bench::report("over: allocations per event", overAllocations, "allocs");
+    bbb::bench::report("over: time per event", over * 1.0e3 / numEvents, "us");
+    bbb::bench::report("over: time per event, far view moving", overMoving * 1.0e3 / numEvents, "us");
+    bbb::bench::report("down + up: callbacks per pair", downUpCalls, "calls");
+    bbb::bench::report("down + up: allocations per pair", downUpAllocations, "allocs");
+    bbb::bench::report("down + up: time per pair", downUp * 1.0e3 / numEvents, "us");
+    bbb::bench::report("before: shared_ptr copies per event, only them", baseline * 1.0e3 / numEvents, "us");
+    
+    root->unregisterEvents();
+}
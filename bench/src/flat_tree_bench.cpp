@@ -0,0 +1,104 @@
+#include "bench.hpp"
+
+#include <random>
+#include <vector>
+
+#include "bbb/view_system/components/view.hpp"
+#include "bbb/view_system/components/flat_tree.hpp"
+
+namespace {
+    using namespace bbb::vs;
+    
+    // n views, each added to a random view created before it. views are scattered around parents and overlap.
+    view::ref randomTree(int n, std::vector<view::ref> &all) {
+        std::mt19937 rng(7);
+        auto rf = [&rng](float a, float b) { return std::uniform_real_distribution<float>(a, b)(rng); };
+        all.clear();
+        auto root = view::create(0, 0, 1000, 1000);
+        all.push_back(root);
+        for(int i = 1; i < n; ++i) {
+            auto &&parent = all[std::uniform_int_distribution<int>(0, static_cast<int>(all.size()) - 1)(rng)];
+            auto v = view::create(rf(-50, 200), rf(-50, 200), rf(5, 150), rf(5, 150));
+            v->setBackgroundColor(0.5f, 0.5f, 0.5f, 1.0f);
+            parent->add(v);
+            all.push_back(v);
+        }
+        return root;
+    }
+};
+
+// full tree traversals of 100k views, by views themselves and by flat_tree.
+// view: moving root and reading global origin and alpha of all views is transform + alpha pass.
+// flat_tree: update copies attributes of views, then runs transform, alpha and bounds passes.
+BBB_BENCH(flat_tree_traversal_100k) {
+    const int n = 100000;
+    std::vector<view::ref> all;
+    auto root = randomTree(n, all);
+    const ofRectangle everything(-1.0e6f, -1.0e6f, 2.0e6f, 2.0e6f);
+    std::vector<view *> hits;
+    background_batch batch;
+    float x = 0.0f;
+    
+    const double viewTransform = bbb::bench::measure([&] {
+        root->setPosition(x = 1.0f - x, 0.0f);
+        root->setAlpha(1.0f - x * 0.01f);
+        float sum = 0.0f;
+        for(auto &&v : all) sum += v->convertToGlobalCoordinate().x + v->getAlpha();
+        bbb::bench::consume(sum);
+    });
+    const double viewCull = bbb::bench::measure([&] { root->draw(everything); });
+    const double viewHits = bbb::bench::measure([&] {
+        std::size_t sum = 0;
+        for(int k = 0; k < 100; ++k) {
+            hits.clear();
+            root->collectHits(ofPoint(k * 10, k * 10), hits);
+            sum += hits.size();
+        }
+        bbb::bench::consume(static_cast<double>(sum));
+    });
+    const double viewBatch = bbb::bench::measure([&] {
+        batch.clear();
+        root->buildBackgroundBatch(batch, everything);
+        bbb::bench::consume(static_cast<double>(batch.getNumQuads()));
+    });
+    
+    flat_tree tree(root);
+    const double flatBuild = bbb::bench::measure([&] { tree.build(root); }, 3);
+    const double flatUpdate = bbb::bench::measure([&] {
+        root->setPosition(x = 1.0f - x, 0.0f);
+        root->setAlpha(1.0f - x * 0.01f);
+        tree.update();
+    });
+    const double flatPasses = bbb::bench::measure([&] {
+        tree.updateTransforms();
+        tree.updateAlphas();
+        tree.updateBounds();
+    });
+    const double flatCull = bbb::bench::measure([&] { bbb::bench::consume(static_cast<double>(tree.cull(everything))); });
+    const double flatHits = bbb::bench::measure([&] {
+        std::size_t sum = 0;
+        for(int k = 0; k < 100; ++k) {
+            hits.clear();
+            tree.collectHits(ofPoint(k * 10, k * 10), hits);
+            sum += hits.size();
+        }
+        bbb::bench::consume(static_cast<double>(sum));
+    });
+    const double flatBatch = bbb::bench::measure([&] {
+        batch.clear();
+        tree.buildBackgroundBatch(batch, everything);
+        bbb::bench::consume(static_cast<double>(batch.getNumQuads()));
+    });
+    
+    std::printf("  %d views\n", n);
+    bbb::bench::report("view: transform + alpha", viewTransform);
+    bbb::bench::report("view: cull (draw)", viewCull);
+    bbb::bench::report("view: 100 hit tests", viewHits);
+    bbb::bench::report("view: background batch", viewBatch);
+    bbb::bench::report("flat_tree: build", flatBuild);
+    bbb::bench::report("flat_tree: update (copy, transform, alpha, bounds)", flatUpdate);
+    bbb::bench::report("flat_tree: transform + alpha + bounds only", flatPasses);
+    bbb::bench::report("flat_tree: cull", flatCull);
+    bbb::bench::report("flat_tree: 100 hit tests", flatHits);
+    bbb::bench::report("flat_tree: background batch", flatBatch);
+}
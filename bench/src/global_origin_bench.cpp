@@ -0,0 +1,63 @@
+#include "bench.hpp"
+
+#include <vector>
+
+#include "bbb/view_system/components/view.hpp"
+
+namespace {
+    using namespace bbb::vs;
+    
+    // same as coordinate conversion before caching: walks parent chain by weak_ptr::lock at every level
+    ofPoint walkParents(const view::ref &v) {
+        ofPoint p;
+        for(view::ref w = v; w; w = w->getParent()) {
+            p += w->getPosition() + ofPoint(w->getSetting().margin.left, w->getSetting().margin.top);
+        }
+        return p;
+    }
+};
+
+// 1000 leaves at each depth. a query is one coordinate conversion of a leaf,
+// repeated 6 times per leaf like left / top / right / bottom / center / isInside.
+BBB_BENCH(global_origin_queries) {
+    const int numLeaves = 1000, queriesPerLeaf = 6;
+    for(int depth : {1, 4, 8, 12}) {
+        auto root = view::create(0, 0, 1000, 1000);
+        std::vector<view::ref> leaves;
+        for(int i = 0; i < numLeaves; ++i) {
+            view::ref parent = root;
+            for(int d = 1; d < depth; ++d) {
+                auto v = view::create(1, 1, 100, 100);
+                parent->add(v);
+                parent = v;
+            }
+            leaves.push_back(view::create(1, 1, 10, 10));
+            parent->add(leaves.back());
+        }
+        const double numQueries = numLeaves * queriesPerLeaf;
+        
+        const double walk = bbb::bench::measure([&] {
+            float sum = 0.0f;
+            for(auto &&v : leaves) for(int q = 0; q < queriesPerLeaf; ++q) sum += walkParents(v).x;
+            bbb::bench::consume(sum);
+        });
+        const double cached = bbb::bench::measure([&] {
+            float sum = 0.0f;
+            for(auto &&v : leaves) for(int q = 0; q < queriesPerLeaf; ++q) sum += v->convertToGlobalCoordinate().x;
+            bbb::bench::consume(sum);
+        });
+        // moving root invalidates all, so first query of each leaf recomputes its chain
+        float x = 0.0f;
+        const double invalidated = bbb::bench::measure([&] {
+            root->setPosition(x += 1.0f, 0.0f);
+            float sum = 0.0f;
+            for(auto &&v : leaves) for(int q = 0; q < queriesPerLeaf; ++q) sum += v->convertToGlobalCoordinate().x;
+            bbb::bench::consume(sum);
+        });
+        
+        std::printf("  depth %d\n", depth);
+        bbb::bench::report("walk parents per query", walk * 1.0e6 / numQueries, "ns");
+        bbb::bench::report("cached per query", cached * 1.0e6 / numQueries, "ns");
+        bbb::bench::report("cached, after moving root (with invalidation)", invalidated * 1.0e6 / numQueries, "ns");
+    }
+}
@@ -0,0 +1,46 @@
+#include "bench.hpp"
+
+#include <vector>
+
+#include "bbb/view_system/components/view.hpp"
+
+// 100 rows of 100 growing leaves, 10k nodes.
+// resizing root changes width of all rows, so all of them are arranged again, same as relayout without dirty flags.
+// resizing one leaf arranges only its row, and root for height of row.
+BBB_BENCH(layout_relayout_10k) {
+    using namespace bbb::vs;
+    namespace lo = bbb::vs::layout;
+    auto root = view::create(0, 0, 10000, 10000);
+    root->setLayout(lo::params().setDirection(lo::axis::vertical).setAlignItems(lo::align::stretch));
+    std::vector<view::ref> leaves;
+    for(int r = 0; r < 100; ++r) {
+        auto row = view::create(0, 0, 100, 100);
+        row->setLayout(lo::params().setDirection(lo::axis::horizontal).setGrow(1));
+        for(int i = 0; i < 100; ++i) {
+            auto leaf = view::create(0, 0, 50, 50);
+            leaf->setLayout(lo::params().setGrow(1));
+            row->add(leaf);
+            leaves.push_back(leaf);
+        }
+        root->add(row);
+    }
+    
+    const double first = bbb::bench::measure([&] { root->updateLayout(); }, 1, 1);
+    int k = 0;
+    const double full = bbb::bench::measure([&] {
+        root->setSize(10000 - (++k % 2), 10000);
+        root->updateLayout();
+    }, 100);
+    const double incremental = bbb::bench::measure([&] {
+        leaves[5050]->setSize(40 + (++k % 20), 50);
+        root->updateLayout();
+    }, 1000);
+    const double clean = bbb::bench::measure([&] { root->updateLayout(); }, 1000);
+    bbb::bench::consume(leaves[5051]->getWidth());
+    
+    std::printf("  %d leaves\n", static_cast<int>(leaves.size()));
+    bbb::bench::report("first layout", first);
+    bbb::bench::report("full relayout (root resized)", full);
+    bbb::bench::report("incremental relayout (one leaf resized)", incremental);
+    bbb::bench::report("nothing changed", clean);
+}
@@ -0,0 +1,11 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+
+#include "bench.hpp"
+
+// headless. give part of benchmark name as argument to run only matching ones.
+int main(int argc, char *argv[]) {
+    ofSetupOpenGL(std::make_shared<ofAppNoWindow>(), 1024, 768, OF_WINDOW);
+    bbb::bench::run(1 < argc ? argv[1] : nullptr);
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include "bench.hpp"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bbb/view_system/components/view.hpp"
+
+// building a container of named children, and looking them up by name.
+// linear is same as before indexing: add(name, v) removes same name by scanning all children first.
+BBB_BENCH(name_index_build_and_find) {
+    using namespace bbb::vs;
+    for(int n : {1000, 10000}) {
+        std::vector<std::string> names;
+        std::vector<view::ref> children;
+        for(int i = 0; i < n; ++i) {
+            names.push_back("child_" + std::to_string(i));
+            children.push_back(view::create(ofRectangle()));
+        }
+        
+        std::vector<std::pair<std::string, view::ref>> linear;
+        const double linearBuild = bbb::bench::measure([&] {
+            linear.clear();
+            for(int i = 0; i < n; ++i) {
+                auto it = std::find_if(linear.begin(), linear.end(), [&](const std::pair<std::string, view::ref> &c) { return c.first == names[i]; });
+                if(it != linear.end()) linear.erase(it);
+                linear.emplace_back(names[i], children[i]);
+            }
+        }, 1, 3);
+        const double linearFind = bbb::bench::measure([&] {
+            std::size_t sum = 0;
+            for(int i = 0; i < n; ++i) {
+                sum += std::find_if(linear.begin(), linear.end(), [&](const std::pair<std::string, view::ref> &c) { return c.first == names[i]; }) - linear.begin();
+            }
+            bbb::bench::consume(static_cast<double>(sum));
+        }, 1, 3);
+        
+        view::ref parent;
+        const double indexedBuild = bbb::bench::measure([&] {
+            parent = view::create(ofRectangle());
+            for(int i = 0; i < n; ++i) parent->add(names[i], children[i]);
+        }, 1, 3);
+        const double indexedFind = bbb::bench::measure([&] {
+            std::size_t sum = 0;
+            for(int i = 0; i < n; ++i) sum += parent->find(names[i]) ? 1 : 0;
+            bbb::bench::consume(static_cast<double>(sum));
+        }, 1, 3);
+        
+        std::printf("  %d named children\n", n);
+        bbb::bench::report("linear: build", linearBuild);
+        bbb::bench::report("linear: find all", linearFind);
+        bbb::bench::report("indexed: build", indexedBuild);
+        bbb::bench::report("indexed: find all", indexedFind);
+    }
+}
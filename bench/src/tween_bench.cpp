@@ -0,0 +1,43 @@
+#include "bench.hpp"
+
+#include <vector>
+
+#include "bbb/view_system/components/view.hpp"
+
+// per frame cost of moving n views, by typed tween and by lambda through std::function like before.
+// both of them call view::setPosition for each view, so cost of only calling it is shown as floor.
+BBB_BENCH(tween_typed_vs_lambda) {
+    using namespace bbb::vs;
+    auto &&manager = animation::manager::get();
+    manager.setClockMode(animation::clock_mode::manual);
+    manager.setAutoUpdate(false);
+    for(int n : {1000, 10000, 100000}) {
+        std::vector<view::ref> views;
+        for(int i = 0; i < n; ++i) views.push_back(view::create(0, 0, 10, 10));
+        
+        float x = 0.0f;
+        const double floor = bbb::bench::measure([&] {
+            x += 0.01f;
+            for(auto &&v : views) v->setPosition(x, x);
+        }, 30);
+        
+        for(auto &&v : views) {
+            const ofPoint from = v->getPosition(), to(100, 100);
+            view *target = v.get();
+            animation::add([target, from, to](float progress) { target->setPosition(from + (to - from) * progress); }, 1000.0f);
+        }
+        const double lambda = bbb::bench::measure([&] { manager.step(1.0f / 60.0f); }, 30);
+        manager.step(10000.0f);
+        
+        for(auto &&v : views) v->tweenTo<tween::property::position>(ofPoint(100, 100), 1000.0f);
+        const double typed = bbb::bench::measure([&] { manager.step(1.0f / 60.0f); }, 30);
+        manager.step(10000.0f);
+        
+        std::printf("  %d tweens, per frame\n", n);
+        bbb::bench::report("setPosition only (floor)", floor);
+        bbb::bench::report("lambda", lambda);
+        bbb::bench::report("typed", typed);
+    }
+    manager.setClockMode(animation::clock_mode::real);
+    manager.setAutoUpdate(true);
+}
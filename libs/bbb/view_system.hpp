@@ -12,5 +12,8 @@
 #include "view_system/components.hpp"
 #include "view_system/animation.hpp"
 #include "view_system/easing.hpp"
+#include "view_system/easing_table.hpp"
+#include "view_system/tween.hpp"
+#include "view_system/arena.hpp"
 
 #endif /* bbb_view_system_hpp */
@@ -9,8 +9,12 @@
 #ifndef bbb_animation_hpp
 #define bbb_animation_hpp
 
+#include <cstdint>
+#include <string>
 #include <functional>
 #include <memory>
+#include <vector>
+#include <algorithm>
 #include <unordered_map>
 
 #include "opt_arg_function.hpp"
@@ -42,27 +46,307 @@ namespace bbb {
     
     namespace view_system {
         class animation {
-            using ref = std::shared_ptr<animation>;
-            using const_ref = std::shared_ptr<const animation>;
+        public:
+            using callback_t = std::function<void(float progress)>;
+            using finish_callback_t = bbb::opt_arg_function<void(const std::string &)>;
+            
+            // identifies added animation. label string is built only when requested.
+            struct handle {
+                handle() = default;
+                handle(std::uint32_t index, std::uint32_t generation, std::uint64_t id, const std::string &label)
+                : index(index)
+                , generation(generation)
+                , id(id)
+                , label(label) {};
+                
+                inline std::uint64_t getId() const { return id; };
+                inline bool isAnonymous() const { return label.empty(); };
+                inline std::string getLabel() const { return isAnonymous() ? anonymous_label(id) : label; };
+                inline operator std::string() const { return getLabel(); };
+                
+                inline bool operator==(const handle &rhs) const { return id == rhs.id; };
+                inline bool operator!=(const handle &rhs) const { return id != rhs.id; };
+            private:
+                friend class animation;
+                std::uint32_t index{0};
+                std::uint32_t generation{0};
+                std::uint64_t id{0};
+                std::string label;
+            };
+            
+            // source of animation time.
+            //  real: elapsed time of app, multiplied by time scale.
+            //  manual: advanced only by manager::step / manager::update.
+            //  fixed_step: advanced by fixed delta time per frame, e.g. for offline rendering.
+            enum class clock_mode : std::uint8_t {
+                real,
+                manual,
+                fixed_step
+            };
+            
+            // group of animations updated together by one call per frame, e.g. tween::batch
+            struct batch {
+                virtual ~batch() {};
+                virtual void update(float currentTime) = 0;
+                virtual std::size_t size() const = 0;
+                // cancels animations of target
+                virtual void cancelTarget(const void *target) = 0;
+            };
+            
+            // animations are stored in slot arrays addressed by handle.
+            // running ones are packed in parallel arrays, so update is a loop over contiguous memory.
             class manager {
-                using animation_map = std::unordered_map<std::string, animation::ref>;
-                animation_map animations;
-                manager() {
-                    ofAddListener(ofEvents().update, this, &manager::update, OF_EVENT_ORDER_BEFORE_APP);
-                }
-                ~manager() {
-                    ofRemoveListener(ofEvents().update, this, &manager::update);
-                }
-                void update(ofEventArgs &) {
-                    const float currentTime = ofGetElapsedTimef();
-                    for(auto it = animations.begin(); it != animations.end();) {
-                        if(it->second->update(currentTime)) {
-                            it->second->finish();
-                            it = animations.erase(it);
+                friend class animation;
+                enum : std::uint32_t {
+                    npos = static_cast<std::uint32_t>(-1),
+                    pending_bit = 1u << 31
+                };
+                
+                // per slot
+                std::vector<std::uint32_t> generations;
+                std::vector<std::uint32_t> locations; // index of packed arrays, pending list (with pending_bit) or npos
+                std::vector<std::uint64_t> ids;
+                std::vector<std::string> labels;
+                std::vector<std::uint32_t> freeSlots;
+                
+                // slots with same key are linked as intrusive list, so cancelling by key is O(k)
+                template <typename key_type>
+                struct tag_list {
+                    std::vector<key_type> keys; // 0 means untagged
+                    std::vector<std::uint32_t> nexts;
+                    std::vector<std::uint32_t> prevs;
+                    std::unordered_map<key_type, std::uint32_t> heads;
+                    
+                    inline void grow() {
+                        keys.push_back(0);
+                        nexts.push_back(npos);
+                        prevs.push_back(npos);
+                    }
+                    inline void reserve(std::size_t n) {
+                        keys.reserve(n);
+                        nexts.reserve(n);
+                        prevs.reserve(n);
+                    }
+                    inline void link(std::uint32_t slot, key_type key) {
+                        unlink(slot);
+                        if(key == 0) return;
+                        keys[slot] = key;
+                        prevs[slot] = npos;
+                        auto it = heads.find(key);
+                        if(it == heads.end()) {
+                            nexts[slot] = npos;
+                            heads.emplace(key, slot);
                         } else {
-                            ++it;
+                            nexts[slot] = it->second;
+                            prevs[it->second] = slot;
+                            it->second = slot;
                         }
                     }
+                    inline void unlink(std::uint32_t slot) {
+                        const key_type key = keys[slot];
+                        if(key == 0) return;
+                        if(nexts[slot] != npos) prevs[nexts[slot]] = prevs[slot];
+                        if(prevs[slot] != npos) nexts[prevs[slot]] = nexts[slot];
+                        else if(nexts[slot] != npos) heads[key] = nexts[slot];
+                        else heads.erase(key);
+                        keys[slot] = 0;
+                        nexts[slot] = prevs[slot] = npos;
+                    }
+                    inline std::uint32_t head(key_type key) const {
+                        auto it = heads.find(key);
+                        return it == heads.end() ? npos : it->second;
+                    }
+                };
+                tag_list<std::uint64_t> owners;
+                tag_list<std::uint32_t> groups;
+                
+                // packed, per running animation
+                std::vector<float> startTimes;
+                std::vector<float> endTimes;
+                std::vector<float> inverseDurations; // 0 means finishing immediately
+                std::vector<float> progresses;
+                std::vector<std::uint8_t> alives;
+                std::vector<std::uint32_t> slots;
+                std::vector<callback_t> callbacks;
+                std::vector<finish_callback_t> finishCallbacks;
+                
+                // added while updating. merged into packed arrays after update.
+                struct pending_animation {
+                    std::uint32_t slot;
+                    float startTime;
+                    float duration;
+                    callback_t callback;
+                    finish_callback_t finishCallback;
+                    bool alive;
+                };
+                std::vector<pending_animation> pendings;
+                
+                std::unordered_map<std::string, std::uint32_t> labelIndex;
+                bool isUpdating{false};
+                bool isErasing{false}; // while callables erased from packed arrays are destroyed
+                bool hasDeadEntries{false};
+                std::string finishingLabel; // reused buffer for label passed to finish callback
+                
+                std::vector<batch *> batches;
+                
+                // clock
+                clock_mode clockMode{clock_mode::real};
+                double currentTime{0.0}; // accumulated in double, for long fixed step sequences
+                float lastRealTime{0.0f};
+                float timeScale{1.0f};
+                float fixedDeltaTime{1.0f / 60.0f};
+                bool bPaused{false};
+                bool bAutoUpdate{false};
+                
+                manager()
+                : currentTime(ofGetElapsedTimef())
+                , lastRealTime(currentTime)
+                { setAutoUpdate(true); }
+                ~manager() { setAutoUpdate(false); }
+                
+                void update(ofEventArgs &) {
+                    switch(clockMode) {
+                        case clock_mode::real: {
+                            const float realTime = ofGetElapsedTimef();
+                            const float delta = realTime - lastRealTime;
+                            lastRealTime = realTime;
+                            step(delta);
+                            break;
+                        }
+                        case clock_mode::fixed_step:
+                            step(fixedDeltaTime);
+                            break;
+                        case clock_mode::manual:
+                            break;
+                    }
+                }
+                
+                inline std::uint32_t allocateSlot(const std::string &label) {
+                    std::uint32_t slot;
+                    if(freeSlots.empty()) {
+                        slot = static_cast<std::uint32_t>(generations.size());
+                        generations.push_back(0);
+                        locations.push_back(npos);
+                        ids.push_back(0);
+                        labels.emplace_back();
+                        owners.grow();
+                        groups.grow();
+                    } else {
+                        slot = freeSlots.back();
+                        freeSlots.pop_back();
+                    }
+                    ids[slot] = issue_id();
+                    labels[slot] = label;
+                    if(!label.empty()) labelIndex[label] = slot;
+                    return slot;
+                }
+                
+                inline void releaseSlot(std::uint32_t slot) {
+                    owners.unlink(slot);
+                    groups.unlink(slot);
+                    if(!labels[slot].empty()) {
+                        labelIndex.erase(labels[slot]);
+                        labels[slot].clear();
+                    }
+                    ++generations[slot];
+                    locations[slot] = npos;
+                    freeSlots.push_back(slot);
+                }
+                
+                inline void push(std::uint32_t slot,
+                                 float startTime,
+                                 float duration,
+                                 callback_t &&callback,
+                                 finish_callback_t &&finishCallback)
+                {
+                    locations[slot] = static_cast<std::uint32_t>(startTimes.size());
+                    startTimes.push_back(startTime);
+                    endTimes.push_back(startTime + duration);
+                    inverseDurations.push_back(duration <= 0.0f ? 0.0f : 1.0f / duration);
+                    progresses.push_back(0.0f);
+                    alives.push_back(1);
+                    slots.push_back(slot);
+                    callbacks.push_back(std::move(callback));
+                    finishCallbacks.push_back(std::move(finishCallback));
+                }
+                
+                // swap with last and pop.
+                // erased callables can hold last reference of a view, and its destructor cancels animations.
+                // so they are destroyed after packed arrays get consistent, and removals by them are only marked.
+                inline void erase(std::size_t i) {
+                    callback_t callback;
+                    finish_callback_t finishCallback;
+                    std::swap(callback, callbacks[i]);
+                    std::swap(finishCallback, finishCallbacks[i]);
+                    
+                    const std::size_t last = startTimes.size() - 1;
+                    if(i != last) {
+                        startTimes[i] = startTimes[last];
+                        endTimes[i] = endTimes[last];
+                        inverseDurations[i] = inverseDurations[last];
+                        progresses[i] = progresses[last];
+                        alives[i] = alives[last];
+                        slots[i] = slots[last];
+                        callbacks[i] = std::move(callbacks[last]);
+                        finishCallbacks[i] = std::move(finishCallbacks[last]);
+                        locations[slots[i]] = static_cast<std::uint32_t>(i);
+                    }
+                    startTimes.pop_back();
+                    endTimes.pop_back();
+                    inverseDurations.pop_back();
+                    progresses.pop_back();
+                    alives.pop_back();
+                    slots.pop_back();
+                    callbacks.pop_back();
+                    finishCallbacks.pop_back();
+                    
+                    const bool wasErasing = isErasing;
+                    isErasing = true;
+                    callback = nullptr;
+                    finishCallback = finish_callback_t();
+                    isErasing = wasErasing;
+                }
+                
+                // erases entries marked while erasing
+                inline void sweep() {
+                    if(isUpdating || isErasing) return;
+                    while(hasDeadEntries) {
+                        hasDeadEntries = false;
+                        for(std::size_t i = startTimes.size(); 0 < i--;) if(!alives[i]) erase(i);
+                    }
+                }
+                
+                inline void removeSlot(std::uint32_t slot) {
+                    const std::uint32_t location = locations[slot];
+                    if(location == npos) return;
+                    // released first, so nested removal by destroyed callables can't reach this slot
+                    releaseSlot(slot);
+                    if(location & pending_bit) {
+                        pendings[location & ~pending_bit].alive = false;
+                    } else if(isUpdating || isErasing) {
+                        alives[location] = 0;
+                        hasDeadEntries = true;
+                    } else {
+                        erase(location);
+                        sweep();
+                    }
+                }
+                
+                inline std::uint32_t slotOf(const handle &h) const {
+                    return (h.index < generations.size() && generations[h.index] == h.generation && locations[h.index] != npos)
+                        ? h.index
+                        : npos;
+                }
+                
+                inline std::uint32_t slotOf(const std::string &label) const {
+                    auto it = labelIndex.find(label);
+                    if(it != labelIndex.end()) return it->second;
+                    std::uint64_t id;
+                    if(!parse_anonymous_label(label, id)) return npos;
+                    for(std::uint32_t slot = 0; slot < ids.size(); ++slot) {
+                        if(ids[slot] == id && locations[slot] != npos && labels[slot].empty()) return slot;
+                    }
+                    return npos;
                 }
                 
             public:
@@ -71,92 +355,278 @@ namespace bbb {
                     return _;
                 }
                 
-                inline std::string add(animation::ref e, const std::string &label) {
-                    animations.insert(std::make_pair(label, e));
-                    return label;
+                inline handle add(callback_t callback,
+                                  float duration,
+                                  float delay,
+                                  const std::string &label,
+                                  finish_callback_t finishCallback,
+                                  std::uint64_t owner = 0,
+                                  std::uint32_t group = 0)
+                {
+                    // same as before: already running animation with same label wins
+                    if(!label.empty()) {
+                        auto it = labelIndex.find(label);
+                        if(it != labelIndex.end()) return handle(it->second, generations[it->second], ids[it->second], label);
+                    }
+                    
+                    const std::uint32_t slot = allocateSlot(label);
+                    owners.link(slot, owner);
+                    groups.link(slot, group);
+                    const float startTime = delay + now();
+                    if(duration < 0.0f) duration = 0.0f;
+                    if(isUpdating) {
+                        locations[slot] = static_cast<std::uint32_t>(pendings.size()) | pending_bit;
+                        pendings.push_back({slot, startTime, duration, std::move(callback), std::move(finishCallback), true});
+                    } else {
+                        push(slot, startTime, duration, std::move(callback), std::move(finishCallback));
+                    }
+                    return handle(slot, generations[slot], ids[slot], label);
+                }
+                
+                inline void remove(const handle &h) {
+                    const std::uint32_t slot = slotOf(h);
+                    if(slot != npos) removeSlot(slot);
                 }
                 
                 inline void remove(const std::string &label) {
-                    animations.erase(label);
+                    const std::uint32_t slot = slotOf(label);
+                    if(slot != npos) removeSlot(slot);
                 }
                 
-                inline animation::ref find(const std::string &label) const {
-                    auto it = std::find_if(animations.begin(), animations.end(), [&label](const animation_map::value_type &pair) {
-                        return pair.first == label;
-                    });
-                    return (it == animations.end()) ? animation::ref() : it->second;
+                // owner is e.g. id of view, and group is any integer except 0.
+                inline void setOwner(const handle &h, std::uint64_t owner) {
+                    const std::uint32_t slot = slotOf(h);
+                    if(slot != npos) owners.link(slot, owner);
+                }
+                inline void setGroup(const handle &h, std::uint32_t group) {
+                    const std::uint32_t slot = slotOf(h);
+                    if(slot != npos) groups.link(slot, group);
+                }
+                
+                // removes all animations of owner / group without calling finish callbacks
+                inline void cancelOwner(std::uint64_t owner) {
+                    if(owner == 0) return;
+                    for(std::uint32_t slot; (slot = owners.head(owner)) != npos;) removeSlot(slot);
+                }
+                inline void cancelGroup(std::uint32_t group) {
+                    if(group == 0) return;
+                    for(std::uint32_t slot; (slot = groups.head(group)) != npos;) removeSlot(slot);
+                }
+                // cancels animations of target in batches, e.g. tweens of a view
+                inline void cancelTarget(const void *target) {
+                    for(auto &&b : batches) b->cancelTarget(target);
+                }
+                
+                inline bool isRunning(const handle &h) const { return slotOf(h) != npos; };
+                inline bool isRunning(const std::string &label) const { return slotOf(label) != npos; };
+                
+                inline std::size_t size() const { return startTimes.size() + pendings.size(); };
+                
+                // animation time. it is used as origin of newly added animations
+                inline float now() const { return static_cast<float>(currentTime); };
+                
+#pragma mark clock
+                
+                inline void setClockMode(clock_mode mode) {
+                    if(mode == clock_mode::real) lastRealTime = ofGetElapsedTimef();
+                    clockMode = mode;
+                }
+                inline clock_mode getClockMode() const { return clockMode; };
+                
+                inline void setTimeScale(float scale) { timeScale = scale < 0.0f ? 0.0f : scale; };
+                inline float getTimeScale() const { return timeScale; };
+                
+                inline void setFixedDeltaTime(float delta) { fixedDeltaTime = delta; };
+                inline float getFixedDeltaTime() const { return fixedDeltaTime; };
+                
+                // while paused, time doesn't advance and animations are not updated
+                inline void pause() { bPaused = true; };
+                inline void resume() { bPaused = false; };
+                inline bool isPaused() const { return bPaused; };
+                
+                // if false, manager is not updated by ofEvents().update and has to be driven by step / update
+                inline void setAutoUpdate(bool isAutoUpdate) {
+                    if(bAutoUpdate == isAutoUpdate) return;
+                    bAutoUpdate = isAutoUpdate;
+                    if(bAutoUpdate) ofAddListener(ofEvents().update, this, &manager::update, OF_EVENT_ORDER_BEFORE_APP);
+                    else ofRemoveListener(ofEvents().update, this, &manager::update, OF_EVENT_ORDER_BEFORE_APP);
+                }
+                inline bool isAutoUpdate() const { return bAutoUpdate; };
+                
+                // advances animation time by delta * time scale, and updates
+                inline void step(float delta) {
+                    if(bPaused) return;
+                    currentTime += static_cast<double>(delta) * timeScale;
+                    updateAnimations(now());
+                }
+                
+                inline void addBatch(batch *b) {
+                    if(std::find(batches.begin(), batches.end(), b) == batches.end()) batches.push_back(b);
+                }
+                inline void removeBatch(batch *b) {
+                    batches.erase(std::remove(batches.begin(), batches.end(), b), batches.end());
+                }
+                
+                // sets animation time to currentTime, and updates
+                void update(float currentTime) {
+                    this->currentTime = currentTime;
+                    updateAnimations(currentTime);
+                }
+                
+                // preallocates buffers for n animations, so adding and finishing up to n animations doesn't allocate.
+                // (except label index of labeled animations and captures of callbacks)
+                inline void reserve(std::size_t n) {
+                    generations.reserve(n);
+                    locations.reserve(n);
+                    ids.reserve(n);
+                    labels.reserve(n);
+                    freeSlots.reserve(n);
+                    owners.reserve(n);
+                    groups.reserve(n);
+                    startTimes.reserve(n);
+                    endTimes.reserve(n);
+                    inverseDurations.reserve(n);
+                    progresses.reserve(n);
+                    alives.reserve(n);
+                    slots.reserve(n);
+                    callbacks.reserve(n);
+                    finishCallbacks.reserve(n);
+                    pendings.reserve(n);
+                    labelIndex.reserve(n);
+                    // "animation_" and up to 20 digits of id
+                    finishingLabel.reserve(32);
+                }
+                
+            private:
+                // in order of:
+                //  1. progress of running animations
+                //  2. animation callbacks
+                //  3. finish callbacks
+                //  4. removals and additions requested in 2 and 3 are applied
+                //  5. batches
+                // while 2 and 3, add / remove don't touch packed arrays: additions are queued in pendings,
+                // removals only mark alive flag. calling update from callbacks is ignored.
+                void updateAnimations(float currentTime) {
+                    if(isUpdating || isErasing) return;
+                    const std::size_t num = startTimes.size();
+                    
+                    for(std::size_t i = 0; i < num; ++i) {
+                        const float t = (currentTime - startTimes[i]) * inverseDurations[i];
+                        progresses[i] = (currentTime < startTimes[i]) ? -1.0f
+                                      : (inverseDurations[i] == 0.0f || 1.0f <= t) ? 1.0f
+                                      : t;
+                    }
+                    
+                    isUpdating = true;
+                    for(std::size_t i = 0; i < num; ++i) {
+                        if(alives[i] && 0.0f <= progresses[i]) callbacks[i](progresses[i]);
+                    }
+                    for(std::size_t i = 0; i < num; ++i) {
+                        if(!alives[i] || progresses[i] < 1.0f) continue;
+                        const std::uint32_t slot = slots[i];
+                        alives[i] = 0;
+                        if(labels[slot].empty()) write_anonymous_label(finishingLabel, ids[slot]);
+                        else finishingLabel.assign(labels[slot]);
+                        releaseSlot(slot);
+                        finishCallbacks[i](finishingLabel);
+                    }
+                    isUpdating = false;
+                    
+                    hasDeadEntries = true;
+                    sweep();
+                    for(auto &&p : pendings) {
+                        if(p.alive) push(p.slot, p.startTime, p.duration, std::move(p.callback), std::move(p.finishCallback));
+                    }
+                    // callables of cancelled pendings are destroyed here
+                    isErasing = true;
+                    pendings.clear();
+                    isErasing = false;
+                    sweep();
+                    
+                    for(auto &&b : batches) b->update(currentTime);
                 }
             };
-            friend class manager;
-
-            std::function<void(float progress)> animationCallback;
-            float duration, delay;
-            std::string label;
-            bbb::opt_arg_function<void(const std::string &)> callback;
-            float startTime, endTime;
             
-            animation(std::function<void(float progress)> animationCallback,
-                      float duration,
-                      float delay,
-                      const std::string &label,
-                      const bbb::opt_arg_function<void(const std::string &)> &callback)
-                : animationCallback(animationCallback)
-                , duration(duration < 0.0f ? 0.0f : duration)
-                , delay(delay)
-                , callback(callback)
-                , label(label)
-            {
-                startTime = delay + ofGetElapsedTimef();
-                endTime = startTime + duration;
+        private:
+            inline static std::uint64_t issue_id() {
+                static std::uint64_t counter{0};
+                return ++counter;
+            }
+            
+            inline static std::string anonymous_label(std::uint64_t id) {
+                return "animation_" + std::to_string(id);
+            }
+            
+            // same as anonymous_label, but reuses capacity of label
+            inline static void write_anonymous_label(std::string &label, std::uint64_t id) {
+                char digits[20];
+                std::size_t n = 0;
+                do {
+                    digits[n++] = static_cast<char>('0' + id % 10);
+                    id /= 10;
+                } while(id);
+                label.assign("animation_");
+                while(n) label.push_back(digits[--n]);
             }
             
-            inline static std::string unique_label() {
-                return "animation_" + std::to_string(rand());
+            inline static bool parse_anonymous_label(const std::string &label, std::uint64_t &id) {
+                static const std::string prefix = "animation_";
+                if(label.size() <= prefix.size() || label.compare(0, prefix.size(), prefix) != 0) return false;
+                id = 0;
+                for(auto it = label.begin() + prefix.size(); it != label.end(); ++it) {
+                    if(*it < '0' || '9' < *it) return false;
+                    id = id * 10 + (*it - '0');
+                }
+                return true;
             }
             
         public:
-            inline static std::string add(std::function<void(float)> animationCallback,
-                                          float duration,
-                                          float delay = 0.0f,
-                                          const std::string &label = unique_label(),
-                                          const bbb::opt_arg_function<void(const std::string &)> &callback = [](const std::string &){})
+            inline static handle add(callback_t animationCallback,
+                                     float duration,
+                                     float delay = 0.0f)
+            {
+                return add(animationCallback, duration, delay, std::string(), [](const std::string &){});
+            }
+            inline static handle add(callback_t animationCallback,
+                                     float duration,
+                                     float delay,
+                                     const std::string &label,
+                                     const finish_callback_t &callback = [](const std::string &){})
             {
-                return manager::get().add(animation::ref(new animation(animationCallback, duration, delay, label, callback)), label);
+                return manager::get().add(animationCallback, duration, delay, label, callback);
             }
-            inline static std::string add(std::function<void(float)> animationCallback,
-                                          float duration,
-                                          const std::string &label,
-                                          const bbb::opt_arg_function<void(const std::string &)> &callback = [](const std::string &){})
+            inline static handle add(callback_t animationCallback,
+                                     float duration,
+                                     const std::string &label,
+                                     const finish_callback_t &callback = [](const std::string &){})
             {
                 return add(animationCallback, duration, 0.0f, label, callback);
             }
-            inline static std::string add(std::function<void(float)> animationCallback,
-                                          float duration,
-                                          float delay,
-                                          const bbb::opt_arg_function<void(const std::string &)> &callback)
+            inline static handle add(callback_t animationCallback,
+                                     float duration,
+                                     float delay,
+                                     const finish_callback_t &callback)
             {
-                return add(animationCallback, duration, delay, unique_label(), callback);
+                return add(animationCallback, duration, delay, std::string(), callback);
             }
-            inline static std::string add(std::function<void(float)> animationCallback,
-                                          float duration,
-                                          const bbb::opt_arg_function<void(const std::string &)> &callback)
+            inline static handle add(callback_t animationCallback,
+                                     float duration,
+                                     const finish_callback_t &callback)
             {
-                return add(animationCallback, duration, 0.0f, unique_label(), callback);
+                return add(animationCallback, duration, 0.0f, std::string(), callback);
             }
             
             inline static void remove(const std::string &label) {
                 manager::get().remove(label);
             }
-            
-            bool update(float time) {
-                if(time < startTime) return false;
-                float progress = (startTime == endTime) ? 1.0f : ofMap(time, startTime, endTime, 0.0f, 1.0f, true);
-                animationCallback(progress);
-                return 1.0f <= progress;
+            inline static void remove(const handle &h) {
+                manager::get().remove(h);
             }
-            
-            void finish() {
-                callback(label);
+            inline static void cancelOwner(std::uint64_t owner) {
+                manager::get().cancelOwner(owner);
+            }
+            inline static void cancelGroup(std::uint32_t group) {
+                manager::get().cancelGroup(group);
             }
         };
     };
@@ -0,0 +1,194 @@
+//
+//  arena.hpp
+//
+//  Created by ISHII 2bit on 2018/03/25.
+//
+
+#pragma once
+
+#ifndef bbb_arena_hpp
+#define bbb_arena_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <typeindex>
+#include <typeinfo>
+#include <algorithm>
+
+namespace bbb {
+    namespace view_system {
+        // fixed size blocks allocated from chunks.
+        // freed blocks are reused through free list, and chunks are released only on destruction.
+        struct pool {
+            pool(std::size_t blockSize, std::size_t blocksPerChunk)
+            : blockSize(roundUp(blockSize))
+            , blocksPerChunk(0 < blocksPerChunk ? blocksPerChunk : 1) {};
+            ~pool() { for(auto &&chunk : chunks) ::operator delete(chunk); };
+            
+            pool(const pool &) = delete;
+            pool &operator=(const pool &) = delete;
+            
+            inline void *allocate() {
+                if(!freeList) grow();
+                free_block *block = freeList;
+                freeList = block->next;
+                ++numAllocated;
+                return block;
+            }
+            
+            inline void deallocate(void *p) {
+                free_block *block = static_cast<free_block *>(p);
+                block->next = freeList;
+                freeList = block;
+                --numAllocated;
+            }
+            
+            inline std::size_t getBlockSize() const { return blockSize; };
+            inline std::size_t getNumAllocated() const { return numAllocated; };
+            inline std::size_t getNumChunks() const { return chunks.size(); };
+            inline std::size_t getBytesReserved() const { return chunks.size() * blocksPerChunk * blockSize; };
+        
+        private:
+            struct free_block { free_block *next; };
+            
+            static inline std::size_t roundUp(std::size_t size) {
+                const std::size_t align = alignof(std::max_align_t);
+                size = (std::max)(size, sizeof(free_block));
+                return (size + align - 1) / align * align;
+            }
+            
+            // blocks are linked in address order, so successive allocations are contiguous
+            inline void grow() {
+                char *chunk = static_cast<char *>(::operator new(blockSize * blocksPerChunk));
+                chunks.push_back(chunk);
+                for(std::size_t i = blocksPerChunk; 0 < i--;) {
+                    free_block *block = reinterpret_cast<free_block *>(chunk + i * blockSize);
+                    block->next = freeList;
+                    freeList = block;
+                }
+            }
+            
+            std::size_t blockSize;
+            std::size_t blocksPerChunk;
+            free_block *freeList{nullptr};
+            std::vector<char *> chunks;
+            std::size_t numAllocated{0};
+        };
+        
+        // one pool per allocated type, so views of same type are packed together.
+        // arena is shared by allocators of objects allocated from it, so memory is released at once
+        // when the last of them is destroyed. (e.g. when a screen is torn down)
+        // NOTE: object and its control block are one block, and it is kept until last weak_ptr to it is gone.
+        //       so a weak_ptr kept somewhere (e.g. in a callback) keeps whole arena, and it is not guaranteed
+        //       that tearing down a screen frees memory at that time.
+        // NOTE: not thread safe.
+        struct arena {
+            using ref = std::shared_ptr<arena>;
+            
+            static arena::ref create(std::size_t blocksPerChunk = 64)
+            { return std::make_shared<arena>(blocksPerChunk); };
+            
+            explicit arena(std::size_t blocksPerChunk = 64)
+            : blocksPerChunk(blocksPerChunk) {};
+            
+            arena(const arena &) = delete;
+            arena &operator=(const arena &) = delete;
+            
+            template <typename type>
+            inline pool &poolOf() {
+                const std::type_index key(typeid(type));
+                for(auto &&entry : pools) if(entry.first == key) return *entry.second;
+                pools.emplace_back(key, std::unique_ptr<pool>(new pool(sizeof(type), blocksPerChunk)));
+                return *pools.back().second;
+            }
+            
+            inline std::size_t getNumAllocated() const {
+                std::size_t num = 0;
+                for(auto &&entry : pools) num += entry.second->getNumAllocated();
+                return num;
+            }
+            inline std::size_t getBytesReserved() const {
+                std::size_t bytes = 0;
+                for(auto &&entry : pools) bytes += entry.second->getBytesReserved();
+                return bytes;
+            }
+            inline std::size_t getNumPools() const { return pools.size(); };
+            
+            // arena used by view::create etc. in current scope. nullptr means default heap.
+            // it is process global, not bound to a tree: any view created while a scoped_arena is alive
+            // goes to the arena, including views created by callbacks or animations run in that scope.
+            static inline arena::ref &current() {
+                static arena::ref _;
+                return _;
+            }
+        
+        private:
+            std::size_t blocksPerChunk;
+            std::vector<std::pair<std::type_index, std::unique_ptr<pool>>> pools;
+        };
+        
+        // allocates single objects from arena. arrays fall back to operator new.
+        template <typename type>
+        struct arena_allocator {
+            using value_type = type;
+            
+            arena_allocator(const arena::ref &owner)
+            : owner(owner) {};
+            template <typename other>
+            arena_allocator(const arena_allocator<other> &rhs)
+            : owner(rhs.owner) {};
+            
+            inline type *allocate(std::size_t n) {
+                if(n == 1) return static_cast<type *>(owner->template poolOf<type>().allocate());
+                return static_cast<type *>(::operator new(n * sizeof(type)));
+            }
+            inline void deallocate(type *p, std::size_t n) {
+                if(n == 1) owner->template poolOf<type>().deallocate(p);
+                else ::operator delete(p);
+            }
+            
+            template <typename other>
+            inline bool operator==(const arena_allocator<other> &rhs) const { return owner == rhs.owner; };
+            template <typename other>
+            inline bool operator!=(const arena_allocator<other> &rhs) const { return owner != rhs.owner; };
+            
+            arena::ref owner;
+        };
+        
+        // while alive, views are created in given arena. it can be nested.
+        // keep the scope around creation code only, and use scoped_arena(nullptr) inside it
+        // for views which must not be torn down with the screen.
+        //
+        //     {
+        //         bbb::vs::scoped_arena scope(screenArena);
+        //         auto screen = bbb::vs::view::create(...); // and its subviews
+        //     }
+        struct scoped_arena {
+            scoped_arena(const arena::ref &a)
+            : previous(std::move(arena::current()))
+            { arena::current() = a; };
+            ~scoped_arena() { arena::current() = std::move(previous); };
+            
+            scoped_arena(const scoped_arena &) = delete;
+            scoped_arena &operator=(const scoped_arena &) = delete;
+        
+        private:
+            arena::ref previous;
+        };
+        
+        // make_shared, or allocate_shared from current arena
+        template <typename type, typename ... arguments>
+        inline std::shared_ptr<type> make_view(arguments && ... args) {
+            auto &&a = arena::current();
+            if(a) return std::allocate_shared<type>(arena_allocator<type>(a), std::forward<arguments>(args) ...);
+            return std::make_shared<type>(std::forward<arguments>(args) ...);
+        }
+    };
+    namespace vs = view_system;
+};
+
+#endif /* bbb_arena_hpp */
@@ -0,0 +1,62 @@
+//
+//  background_batch.hpp
+//
+//  Created by ISHII 2bit on 2018/03/20.
+//
+
+#pragma once
+
+#ifndef bbb_background_batch_hpp
+#define bbb_background_batch_hpp
+
+#include <cstddef>
+
+#include "ofMesh.h"
+#include "ofRectangle.h"
+#include "ofColor.h"
+
+namespace bbb {
+    namespace view_system {
+        // collects background quads in paint order and draws them by one draw call.
+        // each quad is 2 triangles (6 vertices), already transformed and alpha multiplied.
+        struct background_batch {
+            background_batch() { mesh.setMode(OF_PRIMITIVE_TRIANGLES); };
+
+            inline void addQuad(const ofRectangle &rect, const ofFloatColor &color) {
+                const float l = rect.getMinX(), t = rect.getMinY(),
+                            r = rect.getMaxX(), b = rect.getMaxY();
+                mesh.addVertex(ofPoint(l, t));
+                mesh.addVertex(ofPoint(r, t));
+                mesh.addVertex(ofPoint(r, b));
+                mesh.addVertex(ofPoint(l, t));
+                mesh.addVertex(ofPoint(r, b));
+                mesh.addVertex(ofPoint(l, b));
+                for(std::size_t i = 0; i < 6; ++i) mesh.addColor(color);
+            }
+
+            // draws collected quads and clears. buffers keep their capacity.
+            inline void flush() {
+                if(empty()) return;
+                mesh.draw();
+                ++numFlushes;
+                clear();
+            }
+
+            inline void clear() { mesh.clear(); };
+
+            inline bool empty() const { return mesh.getNumVertices() == 0; };
+            inline std::size_t getNumQuads() const { return mesh.getNumVertices() / 6; };
+            inline std::size_t getNumFlushes() const { return numFlushes; };
+            inline void resetNumFlushes() { numFlushes = 0; };
+
+            inline const ofMesh &getMesh() const { return mesh; };
+
+        private:
+            ofMesh mesh;
+            std::size_t numFlushes{0};
+        };
+    };
+    namespace vs = view_system;
+};
+
+#endif /* bbb_background_batch_hpp */
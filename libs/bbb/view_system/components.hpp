@@ -12,7 +12,11 @@
 #include "./components/events.hpp"
 
 #include "./components/view.hpp"
+#include "./components/event_router.hpp"
 #include "./components/image.hpp"
 #include "./components/drawer.hpp"
+#include "./components/scroll_view.hpp"
+#include "./components/list_view.hpp"
+#include "./components/flat_tree.hpp"
 
 #endif /* bbb_components_hpp */
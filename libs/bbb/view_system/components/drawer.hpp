@@ -80,7 +80,7 @@ namespace bbb {
                 }
                 
                 inline static drawer::ref create(const drawer::setting &setting_ = drawer::setting()) {
-                    return std::make_shared<drawer>(setting_);
+                    return make_view<drawer>(setting_);
                 }
                 
                 inline static drawer::ref create(drawCallback callback, float x, float y, float width, float height) {
@@ -92,7 +92,7 @@ namespace bbb {
                 };
                 
                 inline static drawer::ref create(drawCallback callback, const setting &setting_) {
-                    return std::make_shared<drawer>(callback, setting_);
+                    return make_view<drawer>(callback, setting_);
                 };
                 
                 inline drawer(drawCallback callback, const setting &setting_ = setting())
@@ -0,0 +1,623 @@
+//
+//  components/event_router.hpp
+//
+//  Created by ISHII 2bit on 2018/03/23.
+//
+
+#pragma once
+
+#ifndef bbb_components_event_router_hpp
+#define bbb_components_event_router_hpp
+
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+#include "./events.hpp"
+#include "./view.hpp"
+
+#include "ofEvents.h"
+
+namespace bbb {
+    namespace view_system {
+        inline namespace components {
+            // owns subscription of ofEvents, and dispatches mouse / resize events into registered root views.
+            // roots are referred weakly, and receive events in order of registration.
+            //
+            // mouse event is dispatched as below:
+            //  1. hit views of roots are collected (see view::collectHits).
+            //     down and up stop at first view which is not event transparent, so roots are hit-tested
+            //     in order of registration like overlapping siblings, and later roots don't receive them
+            //     if earlier one has such view under pointer. same for targets of touch down.
+            //  2. capture: ancestors of target view (first hit view which is not event transparent), from root.
+            //  3. target: hit views until target view. event transparent views in front of target are included.
+            //  4. bubble: rest of hit views, e.g. ancestors of target in mouse over.
+            // event_arg::stopPropagation stops rest of them.
+            //
+            // on down, target view (or view called capturePointer) captures pointer.
+            // then drag is dispatched only to it, and up only to views received down, without hit-testing.
+            // views are referred by raw pointer with id while dispatching, and views destructed by callbacks are skipped.
+            // id is checked, so a view created at address of destructed one isn't taken as it.
+            //
+            // hovered views (hits of last mouse over) are cached with an area around the pointer where they stay same.
+            // while pointer moves in the area and no view is changed, hit-testing is skipped.
+            // moved or resized views (e.g. by tweens, or scrolling) break it only if their subtrees overlap the area,
+            // or contained hovered views.
+            // enter / leave are dispatched to each view once when it is added to / removed from hovered views.
+            //
+            // if coalescing is enabled, moves received by postMouse are buffered and only the latest one is
+            // dispatched at ofEvents().update, or before next down / up to keep order of them.
+            // movement of skipped moves is accumulated into mouse_event_arg::delta.
+            //
+            // touches are queued by postTouch, and dispatched at ofEvents().update (or flushTouches).
+            // all down points in the queue are hit-tested in one traversal (see view::findTargets),
+            // and each touch keeps its target until up, like pointer capture of mouse.
+            //
+            // dispatch requested by callbacks while dispatching (dispatchMouse, flush, flushTouches, ...)
+            // is deferred until current dispatch is finished, then done in order of requests.
+            struct event_router {
+                static event_router &get() {
+                    static event_router _;
+                    return _;
+                }
+                
+                inline void add(const view_ref &root) {
+                    if(!root || root->isEventRoot_) return;
+                    root->isEventRoot_ = true;
+                    roots.push_back(root);
+                    roots_.push_back(root.get());
+                    view::hitTestChanged();
+                    subscribe();
+                }
+                
+                inline void remove(view *root) {
+                    if(!root || !root->isEventRoot_) return;
+                    root->isEventRoot_ = false;
+                    auto it = std::find(roots_.begin(), roots_.end(), root);
+                    if(it == roots_.end()) return;
+                    roots.erase(roots.begin() + (it - roots_.begin()));
+                    roots_.erase(it);
+                    view::hitTestChanged();
+                    if(roots.empty()) unsubscribe();
+                }
+                
+                inline std::size_t size() const { return roots.size(); };
+
+#pragma mark coalescing
+                
+                inline void setCoalescing(bool isCoalescing) {
+                    if(this->isCoalescing == isCoalescing) return;
+                    if(!isCoalescing) flush();
+                    this->isCoalescing = isCoalescing;
+                }
+                inline bool isCoalescingEnabled() const { return isCoalescing; };
+                
+                // input of mouse event. same as dispatchMouse if coalescing is disabled.
+                void postMouse(mouse_event_type type, const ofPoint &p) {
+                    ++numReceivedEvents;
+                    if(!isCoalescing) {
+                        dispatchMouse(type, p);
+                    } else if(type == mouse_event_type::over || type == mouse_event_type::drag) {
+                        pendingType = type;
+                        pendingMove = p;
+                        hasPendingMove = true;
+                    } else {
+                        flush();
+                        dispatchMouse(type, p);
+                    }
+                }
+                
+                // dispatches buffered move, if exists
+                inline void flush() {
+                    if(!hasPendingMove) return;
+                    hasPendingMove = false;
+                    dispatchMouse(pendingType, pendingMove);
+                }
+                
+                // mouse and touch events received by postMouse, postTouch / dispatched into views
+                inline std::size_t getNumReceivedEvents() const { return numReceivedEvents; };
+                inline std::size_t getNumDispatchedEvents() const { return numDispatchedEvents; };
+                inline void resetEventCounters() { numReceivedEvents = numDispatchedEvents = 0; };
+                
+#pragma mark touch
+                
+                // input of touch event. queued until flushTouches.
+                // if coalescing is enabled, successive moves of same touch are merged.
+                void postTouch(touch_event_type type, int id, const ofPoint &p) {
+                    ++numReceivedEvents;
+                    if(isCoalescing && type == touch_event_type::move) {
+                        for(auto it = touchQueue.rbegin(); it != touchQueue.rend(); ++it) {
+                            if(it->id != id) continue;
+                            if(it->type == touch_event_type::move) {
+                                it->p = p;
+                                return;
+                            }
+                            break;
+                        }
+                    }
+                    touchQueue.push_back({type, id, p});
+                }
+                
+                // hit-tests all queued downs at once, then dispatches queued touches in order.
+                // NOTE: targets of downs are decided before any callback of this flush is called.
+                void flushTouches() {
+                    if(isDispatching) {
+                        isTouchFlushDeferred = true;
+                        return;
+                    }
+                    routeTouches();
+                    dispatchDeferred();
+                }
+                
+                inline std::size_t getNumTouches() const { return touches.size(); };
+                
+#pragma mark dispatch
+
+                // these can be called directly, e.g. for input from other than ofEvents.
+                // they don't care coalescing.
+                
+                void dispatchMouse(mouse_event_type type, const ofPoint &p) {
+                    if(isDispatching) {
+                        deferredMouses.push_back({type, p});
+                        return;
+                    }
+                    routeMouse(type, p);
+                    dispatchDeferred();
+                }
+                
+                void dispatchWindowResized(float width, float height) {
+                    deferredSize.set(width, height);
+                    if(isDispatching) {
+                        hasDeferredResize = true;
+                        return;
+                    }
+                    routeWindowResized();
+                    dispatchDeferred();
+                }
+            
+            private:
+                event_router() {};
+                ~event_router() { unsubscribe(); };
+                
+                // dispatches requests deferred by callbacks. they may defer more requests.
+                void dispatchDeferred() {
+                    while(!deferredMouses.empty() || hasDeferredResize || isTouchFlushDeferred) {
+                        for(std::size_t i = 0; i < deferredMouses.size(); ++i) {
+                            const deferred_mouse e = deferredMouses[i];
+                            routeMouse(e.type, e.p);
+                        }
+                        deferredMouses.clear();
+                        if(hasDeferredResize) {
+                            hasDeferredResize = false;
+                            routeWindowResized();
+                        }
+                        if(isTouchFlushDeferred) {
+                            isTouchFlushDeferred = false;
+                            routeTouches();
+                        }
+                    }
+                }
+                
+                inline void endDispatching() {
+                    isDispatching = false;
+                    destructed.clear();
+                }
+                
+                void routeTouches() {
+                    if(touchQueue.empty()) return;
+                    lockRoots();
+                    queue.swap(touchQueue);
+                    
+                    touchPoints.clear();
+                    for(auto &&t : queue) if(t.type == touch_event_type::down) touchPoints.push_back(t.p);
+                    touchTargets.assign(touchPoints.size(), nullptr);
+                    if(!touchPoints.empty()) {
+                        pendingPoints.clear();
+                        for(std::size_t i = 0; i < touchPoints.size(); ++i) pendingPoints.push_back(i);
+                        for(auto &&root : lockedRoots) root->findTargets(touchPoints, touchTargets, pendingPoints, 0, pendingPoints.size());
+                        // keep targets alive until they are registered as touch_state
+                        touchTargetRefs.clear();
+                        for(auto &&v : touchTargets) touchTargetRefs.push_back(v ? v->shared_from_this() : view_ref());
+                    }
+                    
+                    isDispatching = true;
+                    std::size_t downIndex = 0;
+                    for(auto &&t : queue) {
+                        auto state = std::find_if(touches.begin(), touches.end(), [&t](const touch_state &s) { return s.id == t.id; });
+                        if(t.type == touch_event_type::down) {
+                            auto &&target = touchTargetRefs[downIndex++];
+                            if(state != touches.end()) {
+                                // down without up, e.g. lost up
+                                releaseTouch(*state);
+                                touches.erase(state);
+                            }
+                            touches.push_back({t.id, target, t.p});
+                            if(target) ++target->numTouches_;
+                            dispatchTouch(t.type, t.id, t.p, ofPoint(), target);
+                        } else if(state != touches.end()) {
+                            const ofPoint delta = t.p - state->p;
+                            state->p = t.p;
+                            auto target = state->target.lock();
+                            if(t.type == touch_event_type::up) {
+                                releaseTouch(*state);
+                                touches.erase(state);
+                            }
+                            dispatchTouch(t.type, t.id, t.p, delta, target);
+                        }
+                    }
+                    endDispatching();
+                    
+                    queue.clear();
+                    touchTargetRefs.clear();
+                    lockedRoots.clear();
+                }
+                
+                void routeMouse(mouse_event_type type, const ofPoint &p) {
+                    ++numDispatchedEvents;
+                    currentDelta = hasLastPosition ? p - lastPosition : ofPoint();
+                    lastPosition = p;
+                    hasLastPosition = true;
+                    
+                    if(type == mouse_event_type::drag || type == mouse_event_type::up) {
+                        if(auto v = captured.lock()) {
+                            dispatchCaptured(type, p, v);
+                            return;
+                        }
+                    }
+                    if(type == mouse_event_type::drag) type = mouse_event_type::over;
+                    
+                    lockRoots();
+                    hits.clear();
+                    
+                    if(type == mouse_event_type::over) {
+                        isDispatching = true;
+                        updateHover(p);
+                        for(auto &&v : hovered) hits.push_back(targetOf(v));
+                        if(!hits.empty()) dispatchHits(type, p, targetIndexOf(hits));
+                        endDispatching();
+                        hits.clear();
+                        lockedRoots.clear();
+                        return;
+                    }
+                    
+                    if(type == mouse_event_type::up) {
+                        // pressed views receive up even if it is outside of them
+                        for(auto &&w : pressed) if(auto v = w.lock()) {
+                            v->releaseClick();
+                            hits.push_back(targetOf(v.get()));
+                        }
+                        pressed.clear();
+                    }
+                    const std::size_t numPressed = hits.size();
+                    
+                    collected.clear();
+                    for(auto &&root : lockedRoots) if(root->collectHits(p, collected)) break;
+                    for(auto &&v : collected) {
+                        auto &&isSame = [v](const dispatch_target &t) { return t.v == v; };
+                        if(std::find_if(hits.begin(), hits.begin() + numPressed, isSame) == hits.begin() + numPressed) hits.push_back(targetOf(v));
+                    }
+                    collected.clear();
+                    
+                    if(type == mouse_event_type::down) {
+                        captured.reset();
+                        isCaptureNominated = false;
+                    }
+                    if(!hits.empty()) {
+                        // decided before callbacks, they may destruct views
+                        const std::size_t targetIndex = targetIndexOf(hits);
+                        isDispatching = true;
+                        dispatchHits(type, p, targetIndex);
+                        if(type == mouse_event_type::down && !isCaptureNominated) {
+                            const dispatch_target &t = hits[targetIndex];
+                            if(isAlive(t)) captured = t.v->shared_from_this();
+                        }
+                        endDispatching();
+                    }
+                    
+                    hits.clear();
+                    lockedRoots.clear();
+                }
+                
+                void routeWindowResized() {
+                    lockRoots();
+                    isDispatching = true;
+                    for(auto &&root : lockedRoots) root->windowResized({root.get(), {ofPoint(), deferredSize.x, deferredSize.y}});
+                    endDispatching();
+                    lockedRoots.clear();
+                }
+                
+                inline void lockRoots() {
+                    lockedRoots.clear();
+                    for(auto &&root : roots) if(auto v = root.lock()) lockedRoots.push_back(v);
+                }
+                
+                // view referred while dispatching. id is taken while it is surely alive.
+                struct dispatch_target {
+                    view *v;
+                    std::uint64_t id;
+                };
+                static inline dispatch_target targetOf(view *v) { return {v, v->getId()}; };
+                
+                inline bool isAlive(const dispatch_target &t) const
+                { return destructed.empty() || std::find(destructed.begin(), destructed.end(), t.id) == destructed.end(); };
+                
+                // frame of a view affects hits only in its subtree bounds, and hits of its subtree.
+                inline bool isHoverChangedByFrames() const {
+                    for(auto &&v : view::frameChangedViews()) {
+                        if(v->getGlobalSubtreeBounds().intersects(hoverArea)) return true;
+                        for(auto &&h : hovered) {
+                            for(auto a = h; a; a = a->parent.lock().get()) if(a == v) return true;
+                        }
+                    }
+                    return false;
+                }
+                
+                // refreshes hovered views if pointer went out of hoverArea or views were changed,
+                // and dispatches leave (front to back) and enter (back to front, i.e. parent first).
+                void updateHover(const ofPoint &p) {
+                    if(hoverGeneration == view::hitTestGeneration() && hoverArea.inside(p) && !isHoverChangedByFrames()) {
+                        view::clearFrameChanges();
+                        return;
+                    }
+                    
+                    const float inf = std::numeric_limits<float>::max();
+                    hoverArea.set(-0.5f * inf, -0.5f * inf, inf, inf);
+                    collected.clear();
+                    for(auto &&root : lockedRoots) root->collectHits(p, collected, false, &hoverArea);
+                    
+                    for(auto &&v : hovered) {
+                        if(std::find(collected.begin(), collected.end(), v) == collected.end()) left.push_back(targetOf(v));
+                    }
+                    for(auto it = collected.rbegin(); it != collected.rend(); ++it) {
+                        if(std::find(hovered.begin(), hovered.end(), *it) == hovered.end()) entered.push_back(targetOf(*it));
+                    }
+                    hovered.swap(collected);
+                    collected.clear();
+                    // hit-testing doesn't change views, so generation is taken after it
+                    hoverGeneration = view::hitTestGeneration();
+                    view::clearFrameChanges();
+                    
+                    for(auto &&t : left) {
+                        if(!isAlive(t)) continue;
+                        mouse_event_arg arg{t.v, p, t.v->isInside(p), mouse_event_type::leave};
+                        arg.delta = currentDelta;
+                        t.v->dispatchMouse(arg);
+                    }
+                    for(auto &&t : entered) {
+                        if(!isAlive(t)) continue;
+                        mouse_event_arg arg{t.v, p, true, mouse_event_type::enter};
+                        arg.delta = currentDelta;
+                        t.v->dispatchMouse(arg);
+                    }
+                    left.clear();
+                    entered.clear();
+                }
+                
+                struct queued_touch {
+                    touch_event_type type;
+                    int id;
+                    ofPoint p;
+                };
+                struct touch_state {
+                    int id;
+                    std::weak_ptr<view> target;
+                    ofPoint p;
+                };
+                
+                inline void releaseTouch(const touch_state &state) {
+                    if(auto v = state.target.lock()) if(0 < v->numTouches_) --v->numTouches_;
+                }
+                
+                // to target, then bubbles up to ancestors
+                void dispatchTouch(touch_event_type type, int id, const ofPoint &p, const ofPoint &delta, const view_ref &target) {
+                    if(!target) return;
+                    ++numDispatchedEvents;
+                    bool stopped = false;
+                    touch_event_arg arg{target.get(), id, p, target->isInside(p), type};
+                    arg.delta = delta;
+                    arg.stopped = &stopped;
+                    target->dispatchTouch(arg);
+                    if(!isAlive(targetOf(target.get()))) return;
+                    for(auto v = target->parent.lock(); v && !stopped; v = v->parent.lock()) {
+                        touch_event_arg bubble{v.get(), id, p, v->isInside(p), type, event_phase::bubble};
+                        bubble.delta = delta;
+                        bubble.stopped = &stopped;
+                        v->dispatchTouch(bubble);
+                    }
+                }
+                
+                // first view which is not event transparent
+                static inline std::size_t targetIndexOf(const std::vector<dispatch_target> &views) {
+                    std::size_t i = 0;
+                    while(i + 1 < views.size() && views[i].v->isEventTransparent()) ++i;
+                    return i;
+                }
+                
+                // drag goes to captured view only. up goes to views received down, and releases capture.
+                void dispatchCaptured(mouse_event_type type, const ofPoint &p, const view_ref &target) {
+                    isDispatching = true;
+                    if(type == mouse_event_type::drag) {
+                        mouse_event_arg arg{target.get(), p, target->isInside(p), type};
+                        arg.delta = currentDelta;
+                        target->dispatchMouse(arg);
+                    } else {
+                        captured.reset();
+                        hits.clear();
+                        for(auto &&w : pressed) if(auto v = w.lock()) hits.push_back(targetOf(v.get()));
+                        pressed.clear();
+                        // nominated view may not be hit by down
+                        auto &&isTarget = [&target](const dispatch_target &t) { return t.v == target.get(); };
+                        if(std::find_if(hits.begin(), hits.end(), isTarget) == hits.end()) hits.push_back(targetOf(target.get()));
+                        for(auto &&t : hits) t.v->releaseClick();
+                        dispatchHits(type, p, targetIndexOf(hits), false);
+                        hits.clear();
+                    }
+                    endDispatching();
+                }
+                
+                // targetIndex has to be taken before isDispatching is set, i.e. while all hits are alive.
+                void dispatchHits(mouse_event_type type, const ofPoint &p, std::size_t targetIndex, bool stopAtOpaque = true) {
+                    bool stopped = false;
+                    
+                    path.clear();
+                    for(auto v = hits[targetIndex].v->parent.lock(); v; v = v->parent.lock()) path.push_back(targetOf(v.get()));
+                    for(auto it = path.rbegin(); it != path.rend() && !stopped; ++it) {
+                        if(!isAlive(*it)) continue;
+                        mouse_event_arg arg{it->v, p, false, type, event_phase::capture};
+                        arg.delta = currentDelta;
+                        arg.stopped = &stopped;
+                        it->v->dispatchMouse(arg);
+                    }
+                    path.clear();
+                    
+                    for(std::size_t i = 0; i < hits.size() && !stopped; ++i) {
+                        const dispatch_target t = hits[i];
+                        if(!isAlive(t)) continue;
+                        view *v = t.v;
+                        mouse_event_arg arg{v, p, v->isInside(p), type, i <= targetIndex ? event_phase::target : event_phase::bubble};
+                        arg.delta = currentDelta;
+                        arg.stopped = &stopped;
+                        if(type == mouse_event_type::down) pressed.push_back(v->shared_from_this());
+                        v->dispatchMouse(arg);
+                        if(!isAlive(t)) continue;
+                        if(stopAtOpaque && type != mouse_event_type::over && !v->isEventTransparent()) break;
+                    }
+                }
+                
+                inline void subscribe() {
+                    if(isSubscribed) return;
+                    isSubscribed = true;
+                    auto &&events = ofEvents();
+                    ofAddListener(events.mousePressed, this, &event_router::mousePressed, OF_EVENT_ORDER_BEFORE_APP);
+                    ofAddListener(events.mouseReleased, this, &event_router::mouseReleased, OF_EVENT_ORDER_BEFORE_APP);
+                    ofAddListener(events.mouseMoved, this, &event_router::mouseMoved, OF_EVENT_ORDER_BEFORE_APP);
+                    ofAddListener(events.mouseDragged, this, &event_router::mouseDragged, OF_EVENT_ORDER_BEFORE_APP);
+                    ofAddListener(events.windowResized, this, &event_router::windowResized, OF_EVENT_ORDER_BEFORE_APP);
+                    ofAddListener(events.touchDown, this, &event_router::touchDown, OF_EVENT_ORDER_BEFORE_APP);
+                    ofAddListener(events.touchMoved, this, &event_router::touchMoved, OF_EVENT_ORDER_BEFORE_APP);
+                    ofAddListener(events.touchUp, this, &event_router::touchUp, OF_EVENT_ORDER_BEFORE_APP);
+                    ofAddListener(events.touchCancelled, this, &event_router::touchUp, OF_EVENT_ORDER_BEFORE_APP);
+                    ofAddListener(events.update, this, &event_router::update, OF_EVENT_ORDER_BEFORE_APP);
+                }
+                
+                inline void unsubscribe() {
+                    if(!isSubscribed) return;
+                    isSubscribed = false;
+                    auto &&events = ofEvents();
+                    ofRemoveListener(events.mousePressed, this, &event_router::mousePressed, OF_EVENT_ORDER_BEFORE_APP);
+                    ofRemoveListener(events.mouseReleased, this, &event_router::mouseReleased, OF_EVENT_ORDER_BEFORE_APP);
+                    ofRemoveListener(events.mouseMoved, this, &event_router::mouseMoved, OF_EVENT_ORDER_BEFORE_APP);
+                    ofRemoveListener(events.mouseDragged, this, &event_router::mouseDragged, OF_EVENT_ORDER_BEFORE_APP);
+                    ofRemoveListener(events.windowResized, this, &event_router::windowResized, OF_EVENT_ORDER_BEFORE_APP);
+                    ofRemoveListener(events.touchDown, this, &event_router::touchDown, OF_EVENT_ORDER_BEFORE_APP);
+                    ofRemoveListener(events.touchMoved, this, &event_router::touchMoved, OF_EVENT_ORDER_BEFORE_APP);
+                    ofRemoveListener(events.touchUp, this, &event_router::touchUp, OF_EVENT_ORDER_BEFORE_APP);
+                    ofRemoveListener(events.touchCancelled, this, &event_router::touchUp, OF_EVENT_ORDER_BEFORE_APP);
+                    ofRemoveListener(events.update, this, &event_router::update, OF_EVENT_ORDER_BEFORE_APP);
+                }
+                
+                inline void mousePressed(ofMouseEventArgs &arg)
+                { postMouse(mouse_event_type::down, ofPoint(arg.x, arg.y)); };
+                inline void mouseReleased(ofMouseEventArgs &arg)
+                { postMouse(mouse_event_type::up, ofPoint(arg.x, arg.y)); };
+                inline void mouseMoved(ofMouseEventArgs &arg)
+                { postMouse(mouse_event_type::over, ofPoint(arg.x, arg.y)); };
+                inline void mouseDragged(ofMouseEventArgs &arg)
+                { postMouse(mouse_event_type::drag, ofPoint(arg.x, arg.y)); };
+                inline void touchDown(ofTouchEventArgs &arg)
+                { postTouch(touch_event_type::down, arg.id, ofPoint(arg.x, arg.y)); };
+                inline void touchMoved(ofTouchEventArgs &arg)
+                { postTouch(touch_event_type::move, arg.id, ofPoint(arg.x, arg.y)); };
+                inline void touchUp(ofTouchEventArgs &arg)
+                { postTouch(touch_event_type::up, arg.id, ofPoint(arg.x, arg.y)); };
+                inline void update(ofEventArgs &) {
+                    flush();
+                    flushTouches();
+                };
+                inline void windowResized(ofResizeEventArgs &arg)
+                { dispatchWindowResized(arg.width, arg.height); };
+                
+                std::vector<std::weak_ptr<view>> roots;
+                std::vector<view *> roots_; // same order as roots, to find root being destructed
+                std::vector<std::weak_ptr<view>> pressed;
+                std::weak_ptr<view> captured;
+                bool isCaptureNominated{false};
+                bool isSubscribed{false};
+                
+                ofPoint lastPosition;
+                ofPoint currentDelta;
+                bool hasLastPosition{false};
+                
+                bool isCoalescing{false};
+                bool hasPendingMove{false};
+                mouse_event_type pendingType{mouse_event_type::over};
+                ofPoint pendingMove;
+                std::size_t numReceivedEvents{0};
+                std::size_t numDispatchedEvents{0};
+                
+                std::vector<touch_state> touches;
+                std::vector<queued_touch> touchQueue;
+                std::vector<queued_touch> queue; // being flushed
+                std::vector<ofPoint> touchPoints;
+                std::vector<view *> touchTargets;
+                std::vector<view_ref> touchTargetRefs;
+                std::vector<std::size_t> pendingPoints;
+                
+                // reused buffers
+                std::vector<view_ref> lockedRoots;
+                std::vector<dispatch_target> hits;
+                std::vector<view *> collected;
+                std::vector<dispatch_target> path;
+                std::vector<dispatch_target> left;
+                std::vector<dispatch_target> entered;
+                
+                // views under pointer at last mouse over, in dispatching order
+                std::vector<view *> hovered;
+                ofRectangle hoverArea;
+                std::uint64_t hoverGeneration{0};
+                
+                // ids of views destructed while dispatching
+                bool isDispatching{false};
+                std::vector<std::uint64_t> destructed;
+                
+                // requested by callbacks while dispatching
+                struct deferred_mouse {
+                    mouse_event_type type;
+                    ofPoint p;
+                };
+                std::vector<deferred_mouse> deferredMouses;
+                bool hasDeferredResize{false};
+                ofPoint deferredSize;
+                bool isTouchFlushDeferred{false};
+                
+                friend struct view;
+            };
+            
+            inline void view::registerEvents() { event_router::get().add(shared_from_this()); }
+            inline void view::unregisterEvents() { event_router::get().remove(this); }
+            inline void view::capturePointer() {
+                auto &&router = event_router::get();
+                router.captured = shared_from_this();
+                router.isCaptureNominated = true;
+            }
+            inline void view::releasePointerCapture() {
+                auto &&router = event_router::get();
+                if(hasPointerCapture()) router.captured.reset();
+            }
+            inline bool view::hasPointerCapture() const {
+                return event_router::get().captured.lock().get() == this;
+            }
+            inline void view::forgetEvents() {
+                auto &&router = event_router::get();
+                if(router.isDispatching) router.destructed.push_back(id_);
+                auto &&hovered = router.hovered;
+                hovered.erase(std::remove(hovered.begin(), hovered.end(), this), hovered.end());
+                if(isEventRoot_) router.remove(this);
+            }
+        };
+    };
+    namespace vs = view_system;
+};
+
+#endif /* bbb_components_event_router_hpp */
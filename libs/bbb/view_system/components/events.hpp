@@ -9,6 +9,7 @@
 #ifndef bbb_components_events_hpp
 #define bbb_components_events_hpp
 
+#include <cstdint>
 #include <functional>
 #include "../opt_arg_function.hpp"
 #include <memory>
@@ -20,25 +21,93 @@ namespace bbb {
     namespace view_system {
         inline namespace components {
             using view_ref = std::shared_ptr<struct view>;
+            struct event_router;
             
+            // capture: from root to parent of hit view.
+            // target: first hit view.
+            // bubble: rest of hit views, e.g. views behind event transparent view, or its ancestors.
+            enum class event_phase : std::uint8_t {
+                capture,
+                target,
+                bubble
+            };
+            
+            // enter and leave are dispatched only to the view itself, once per transition.
+            // drag is dispatched only to the view capturing pointer. (without capture, it is dispatched as over)
+            enum class mouse_event_type : std::uint8_t {
+                down,
+                up,
+                over,
+                enter,
+                leave,
+                drag
+            };
+            
+            // target is not owning reference, and valid while the callback is running.
+            // use ref() to keep target after that.
             struct event_arg {
-                event_arg(view_ref target)
-                : target(target) {};
+                event_arg(struct view *target, event_phase phase = event_phase::target)
+                : target(target)
+                , phase(phase) {};
                 
-                view_ref target;
+                inline view_ref ref() const; // defined in view.hpp
+                
+                // stops dispatching this event to rest of views (and rest of phases)
+                inline void stopPropagation() const { if(stopped) *stopped = true; };
+                inline bool isPropagationStopped() const { return stopped && *stopped; };
+                
+                struct view *target;
+                event_phase phase;
+            private:
+                friend struct event_router;
+                bool *stopped{nullptr};
             };
             struct mouse_event_arg : public event_arg {
-                mouse_event_arg(view_ref target, ofPoint p, bool isInside)
-                : event_arg(target)
+                mouse_event_arg(struct view *target,
+                                const ofPoint &p,
+                                bool isInside,
+                                mouse_event_type type = mouse_event_type::over,
+                                event_phase phase = event_phase::target)
+                : event_arg(target, phase)
+                , p(p)
+                , isInside(isInside)
+                , type(type) {};
+                
+                ofPoint p;
+                bool isInside;
+                mouse_event_type type;
+                ofPoint delta; // pointer movement since previous dispatched event, includes coalesced moves
+            };
+            
+            // target of a touch is fixed at down. move and up go to it even if it is outside.
+            enum class touch_event_type : std::uint8_t {
+                down,
+                move,
+                up
+            };
+            
+            struct touch_event_arg : public event_arg {
+                touch_event_arg(struct view *target,
+                                int id,
+                                const ofPoint &p,
+                                bool isInside,
+                                touch_event_type type,
+                                event_phase phase = event_phase::target)
+                : event_arg(target, phase)
+                , id(id)
                 , p(p)
-                , isInside(isInside) {};
+                , isInside(isInside)
+                , type(type) {};
                 
+                int id;
                 ofPoint p;
                 bool isInside;
+                touch_event_type type;
+                ofPoint delta; // movement of this touch since previous dispatched event
             };
             
             struct resized_event_arg : public event_arg {
-                resized_event_arg(view_ref target, const ofRectangle &rect)
+                resized_event_arg(struct view *target, const ofRectangle &rect)
                 : event_arg(target)
                 , rect(rect) {};
                 
@@ -48,6 +117,7 @@ namespace bbb {
             using click_down_callback_t = bbb::opt_arg_function<void(mouse_event_arg)>;
             using click_up_callback_t = bbb::opt_arg_function<void(mouse_event_arg)>;
             using mouse_over_callback_t = bbb::opt_arg_function<void(mouse_event_arg)>;
+            using touch_callback_t = bbb::opt_arg_function<void(touch_event_arg)>;
             using window_resized_callback_t = bbb::opt_arg_function<void(resized_event_arg)>;
         };
     };
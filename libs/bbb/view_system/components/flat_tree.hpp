@@ -0,0 +1,317 @@
+//
+//  components/flat_tree.hpp
+//
+//  Created by ISHII 2bit on 2018/03/25.
+//
+
+#pragma once
+
+#ifndef bbb_components_flat_tree_hpp
+#define bbb_components_flat_tree_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+
+#include "./view.hpp"
+#include "../background_batch.hpp"
+
+namespace bbb {
+    namespace view_system {
+        inline namespace components {
+            // flat copy of a view tree: parallel arrays of attributes in depth first order.
+            // parent of view i is parents[i] (< i), and its subtree is [i, ends[i]).
+            // transform / alpha / culling / hit test / background batching run over these arrays,
+            // instead of following shared_ptrs of subviews.
+            // views are still owner of attributes. update() copies them, and rebuilds arrays when
+            // any view got or lost subview (view::structureGeneration).
+            //
+            //     bbb::vs::flat_tree tree(root);
+            //     // every frame
+            //     tree.update();
+            //     tree.cull(ofGetWindowRect());
+            //     view *target = tree.hitTest(p);
+            //
+            // NOTE: views are referred by raw pointer. call update() after changing tree before other functions.
+            struct flat_tree {
+                using index_t = std::uint32_t;
+                
+                struct flags {
+                    enum : std::uint8_t {
+                        none = 0,
+                        visible = 1 << 0,
+                        event_transparent = 1 << 1,
+                        user_interaction = 1 << 2,
+                        clip_subviews = 1 << 3
+                    };
+                };
+                
+                flat_tree() {};
+                flat_tree(const view::ref &root) { build(root); };
+                
+                inline void build(const view::ref &root) {
+                    this->root = root;
+                    handles.clear();
+                    parents.clear();
+                    ends.clear();
+                    lastChildren.clear();
+                    previousSiblings.clear();
+                    positions.clear();
+                    margins.clear();
+                    frames.clear();
+                    localAlphas.clear();
+                    alphas.clear();
+                    backgroundColors.clear();
+                    nodeFlags.clear();
+                    bounds.clear();
+                    areas.clear();
+                    clippedAreas.clear();
+                    drawn.clear();
+                    indices.clear();
+                    generation = view::structureGeneration();
+                    if(!root) return;
+                    append(*root, 0);
+                    syncBase();
+                    calculate();
+                }
+                
+                // rebuilds arrays if structure is changed, otherwise copies attributes only.
+                // then calculates global frames, alphas and subtree bounds.
+                inline void update() {
+                    if(!root) return;
+                    root->updateLayout();
+                    if(generation != view::structureGeneration()) {
+                        build(root);
+                        return;
+                    }
+                    syncBase();
+                    for(index_t i = 0; i < size(); ++i) sync(i);
+                    calculate();
+                }
+                
+                inline std::size_t size() const { return handles.size(); };
+                inline bool empty() const { return handles.empty(); };
+                inline const view::ref &getRoot() const { return root; };
+
+#pragma mark passes
+
+                // global origin of view is parent's one + position + margin
+                inline void updateTransforms() {
+                    if(empty()) return;
+                    frames[0].x = baseOrigin.x + (positions[0].x + margins[0].left);
+                    frames[0].y = baseOrigin.y + (positions[0].y + margins[0].top);
+                    for(index_t i = 1; i < size(); ++i) {
+                        const ofRectangle &parent = frames[parents[i]];
+                        frames[i].x = parent.x + (positions[i].x + margins[i].left);
+                        frames[i].y = parent.y + (positions[i].y + margins[i].top);
+                    }
+                }
+                
+                inline void updateAlphas() {
+                    if(empty()) return;
+                    alphas[0] = baseAlpha * localAlphas[0];
+                    for(index_t i = 1; i < size(); ++i) alphas[i] = alphas[parents[i]] * localAlphas[i];
+                }
+                
+                // global bounds of view and its visible subviews.
+                // calculated in local coordinate in same order as view::getSubtreeBounds, to get same float values.
+                inline void updateBounds() {
+                    // subviews are after parent, so they are done before parent in backward pass
+                    for(index_t i = static_cast<index_t>(size()); 0 < i--;) {
+                        const layout::margin &margin = margins[i];
+                        bounds[i].set(0.0f, 0.0f, frames[i].width, frames[i].height);
+                        bounds[i].growToInclude(ofRectangle(margin.left, margin.top,
+                                                            frames[i].width - (margin.left + margin.right),
+                                                            frames[i].height + (margin.top - margin.bottom)));
+                        for(index_t j = i + 1; j < ends[i]; j = ends[j]) {
+                            if(!(nodeFlags[j] & flags::visible)) continue;
+                            ofRectangle r = bounds[j];
+                            r.translate(positions[j] + ofPoint(margins[j].left, margins[j].top));
+                            bounds[i].growToInclude(r);
+                        }
+                    }
+                    for(index_t i = 0; i < size(); ++i) bounds[i].translate(frames[i].getPosition());
+                }
+                
+                // marks views drawn by view::draw(visibleRect), and returns number of them
+                inline std::size_t cull(const ofRectangle &visibleRect)
+                { return walk(visibleRect, nullptr); };
+                
+                // same result as view::collectHits of root: front to back, subviews before itself.
+                inline bool collectHits(const ofPoint &p, std::vector<view *> &hits, bool stopAtOpaque = true) const {
+                    return !empty() && collectHitsFrom(0, p, hits, stopAtOpaque);
+                }
+                
+                // front-most view hit by p which is not event transparent, or nullptr. same as target of event_router.
+                inline view *hitTest(const ofPoint &p) {
+                    hitBuffer.clear();
+                    return collectHits(p, hitBuffer) ? hitBuffer.back() : nullptr;
+                }
+                
+                // same quads as view::buildBackgroundBatch of root. views are also marked as cull.
+                inline void buildBackgroundBatch(background_batch &batch, const ofRectangle &visibleRect)
+                { walk(visibleRect, &batch); };
+                inline void buildBackgroundBatch(background_batch &batch)
+                { walk(ofGetWindowRect(), &batch); };
+
+#pragma mark nodes
+
+                inline view *getView(index_t i) const { return handles[i]; };
+                // size() if v isn't in tree
+                inline index_t indexOf(const view *v) const {
+                    auto &&it = indices.find(v);
+                    return it == indices.end() ? static_cast<index_t>(size()) : it->second;
+                }
+                
+                inline index_t getParent(index_t i) const { return parents[i]; };
+                inline index_t getSubtreeEnd(index_t i) const { return ends[i]; };
+                inline const ofRectangle &getGlobalFrame(index_t i) const { return frames[i]; };
+                inline const ofRectangle &getGlobalSubtreeBounds(index_t i) const { return bounds[i]; };
+                inline float getAlpha(index_t i) const { return alphas[i]; };
+                inline std::uint8_t getFlags(index_t i) const { return nodeFlags[i]; };
+                // result of last cull
+                inline bool isDrawn(index_t i) const { return i < drawn.size() && drawn[i]; };
+            
+            private:
+                inline void append(view &v, index_t parent) {
+                    const index_t i = static_cast<index_t>(size());
+                    handles.push_back(&v);
+                    parents.push_back(parent);
+                    ends.push_back(i + 1);
+                    lastChildren.push_back(0);
+                    previousSiblings.push_back(0);
+                    if(i != 0) {
+                        previousSiblings[i] = lastChildren[parent];
+                        lastChildren[parent] = i;
+                    }
+                    positions.emplace_back();
+                    margins.emplace_back();
+                    frames.emplace_back();
+                    localAlphas.push_back(1.0f);
+                    alphas.push_back(1.0f);
+                    backgroundColors.emplace_back();
+                    nodeFlags.push_back(flags::none);
+                    bounds.emplace_back();
+                    areas.emplace_back();
+                    clippedAreas.push_back(0);
+                    indices.emplace(&v, i);
+                    sync(i);
+                    for(auto &&subview : v.subviews) append(*subview, i);
+                    ends[i] = static_cast<index_t>(size());
+                }
+                
+                inline void sync(index_t i) {
+                    const view &v = *handles[i];
+                    const view::setting &s = v.setting_;
+                    positions[i] = v.position;
+                    margins[i] = s.margin;
+                    frames[i].width = v.width;
+                    frames[i].height = v.height;
+                    localAlphas[i] = s.alpha;
+                    backgroundColors[i] = s.backgroundColor;
+                    nodeFlags[i] = (s.isVisible ? flags::visible : flags::none)
+                                 | (s.isEventTransparent ? flags::event_transparent : flags::none)
+                                 | (s.isEnabledUserInteraction ? flags::user_interaction : flags::none)
+                                 | (s.isClippingSubviews ? flags::clip_subviews : flags::none);
+                }
+                
+                // root may be a subview of other view
+                inline void syncBase() {
+                    auto &&p = root->parent.lock();
+                    baseOrigin = p ? p->globalOrigin() : ofPoint();
+                    baseAlpha = p ? p->getAlpha() : 1.0f;
+                }
+                
+                inline void calculate() {
+                    updateTransforms();
+                    updateAlphas();
+                    updateBounds();
+                }
+                
+                // same as view::hitRect(topLeft())
+                inline ofRectangle hitRect(index_t i) const {
+                    const ofRectangle &frame = frames[i];
+                    const layout::margin &margin = margins[i];
+                    return ofRectangle(frame.x + margin.left, frame.y + margin.top,
+                                       frame.width - (margin.left + margin.right),
+                                       frame.height + (margin.top - margin.bottom));
+                }
+                
+                // same walk as view::drawTree / appendToBatch
+                inline std::size_t walk(const ofRectangle &visibleRect, background_batch *batch) {
+                    drawn.assign(size(), 0);
+                    std::size_t numDrawn = 0;
+                    for(index_t i = 0; i < size();) {
+                        const ofRectangle &area = i == 0 ? visibleRect : areas[parents[i]];
+                        const bool isClipped = i != 0 && clippedAreas[parents[i]];
+                        if(!(nodeFlags[i] & flags::visible) || alphas[i] <= 0.0f || !area.intersects(bounds[i])) {
+                            i = ends[i];
+                            continue;
+                        }
+                        drawn[i] = 1;
+                        ++numDrawn;
+                        if(batch) {
+                            const ofFloatColor &bg = backgroundColors[i];
+                            const float a = bg.a * alphas[i];
+                            if(0.0f < a) {
+                                const ofRectangle quad = isClipped ? area.getIntersection(frames[i]) : frames[i];
+                                if(0.0f < quad.width && 0.0f < quad.height) batch->addQuad(quad, ofFloatColor(bg.r, bg.g, bg.b, a));
+                            }
+                        }
+                        // area where subviews are drawn
+                        const bool isClipping = nodeFlags[i] & flags::clip_subviews;
+                        areas[i] = isClipping ? area.getIntersection(frames[i]) : area;
+                        clippedAreas[i] = isClipping || isClipped;
+                        ++i;
+                    }
+                    return numDrawn;
+                }
+                
+                inline bool isHit(index_t i, const ofPoint &p) const
+                { return (nodeFlags[i] & flags::user_interaction) && hitRect(i).inside(p); };
+                
+                inline bool collectHitsFrom(index_t i, const ofPoint &p, std::vector<view *> &hits, bool stopAtOpaque) const {
+                    if(!(nodeFlags[i] & flags::visible) || !bounds[i].inside(p)) return false;
+                    // not clipped out
+                    if(!(nodeFlags[i] & flags::clip_subviews) || frames[i].inside(p)) {
+                        for(index_t j = lastChildren[i]; j != 0; j = previousSiblings[j]) {
+                            if(collectHitsFrom(j, p, hits, stopAtOpaque)) return true;
+                        }
+                    }
+                    if(!isHit(i, p)) return false;
+                    hits.push_back(handles[i]);
+                    return stopAtOpaque && !(nodeFlags[i] & flags::event_transparent);
+                }
+                
+                view::ref root;
+                std::uint64_t generation{0};
+                ofPoint baseOrigin;
+                float baseAlpha{1.0f};
+                
+                std::vector<view *> handles;
+                std::vector<index_t> parents;
+                std::vector<index_t> ends;
+                // for hit test from front. 0 means none, because root can't be a subview.
+                std::vector<index_t> lastChildren;
+                std::vector<index_t> previousSiblings;
+                std::vector<ofPoint> positions;
+                std::vector<layout::margin> margins;
+                std::vector<ofRectangle> frames; // global
+                std::vector<float> localAlphas;
+                std::vector<float> alphas;
+                std::vector<ofFloatColor> backgroundColors;
+                std::vector<std::uint8_t> nodeFlags;
+                std::vector<ofRectangle> bounds; // global
+                std::vector<ofRectangle> areas; // where subviews are drawn
+                std::vector<std::uint8_t> clippedAreas; // area is cut by clipping view
+                std::vector<std::uint8_t> drawn;
+                std::unordered_map<const view *, index_t> indices;
+                std::vector<view *> hitBuffer;
+            };
+        }; // components
+    }; // view_system
+    namespace vs = view_system;
+}; // bbb
+
+#endif /* bbb_components_flat_tree_hpp */
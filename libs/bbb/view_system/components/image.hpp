@@ -84,15 +84,15 @@ namespace bbb {
                     top_left
                 };
                 
-                inline static image::ref create() { return std::make_shared<image>(); }
+                inline static image::ref create() { return make_view<image>(); }
                 
                 template <typename _>
                 inline static image::ref create(const view::setting_base<_> &setting_)
-                { return std::make_shared<image>(setting_); }
+                { return make_view<image>(setting_); }
                 
                 template <typename _>
                 inline static image::ref create(const setting_base<_> &setting_)
-                { return std::make_shared<image>(setting_); }
+                { return make_view<image>(setting_); }
                 
                 inline static image::ref create(const ofRectangle &rect)
                 { return create(setting(rect)); }
@@ -104,12 +104,12 @@ namespace bbb {
                 template <typename _>
                 inline static image::ref create(const ofImage &image_,
                                                 const view::setting_base<_> &setting_ = {})
-                { return std::make_shared<image>(image_, setting_); };
+                { return make_view<image>(image_, setting_); };
                 
                 template <typename _>
                 inline static image::ref create(const ofImage &image_,
                                                 const setting_base<_> &setting_ = {})
-                { return std::make_shared<image>(image_, setting_); };
+                { return make_view<image>(image_, setting_); };
                 
                 inline static image::ref create(const ofImage &image_,
                                                 const ofRectangle &rect)
@@ -126,7 +126,7 @@ namespace bbb {
                 {
                     setting setting__(setting_);
                     setting__.imagePath = imagePath;
-                    return std::make_shared<image>(setting__);
+                    return make_view<image>(setting__);
                 };
                 
                 template <typename _>
@@ -135,7 +135,7 @@ namespace bbb {
                 {
                     setting setting__(setting_);
                     setting__.imagePath = imagePath;
-                    return std::make_shared<image>(setting__);
+                    return make_view<image>(setting__);
                 };
                 
                 inline static image::ref create(const boost::filesystem::path &imagePath,
@@ -0,0 +1,197 @@
+//
+//  components/list_view.hpp
+//
+//  Created by ISHII 2bit on 2018/03/24.
+//
+
+#pragma once
+
+#ifndef bbb_components_list_view_hpp
+#define bbb_components_list_view_hpp
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+#include "./scroll_view.hpp"
+
+namespace bbb {
+    namespace view_system {
+        inline namespace components {
+            // vertical list of rows with same height.
+            // only rows intersecting visible area have cell views. cells of rows scrolled out are hidden and
+            // kept in reuse pool, then bound to other rows. so number of cells depends only on height of list.
+            //
+            //     auto list = list_view::create(0, 0, 300, 600);
+            //     list->onCreateCell([] { return view::create(ofRectangle()); });
+            //     list->onBindCell([](view::ref cell, std::size_t row) { ... });
+            //     list->setNumberOfRows(100000);
+            struct list_view : public scroll_view {
+                using ref = std::shared_ptr<list_view>;
+                using const_ref = std::shared_ptr<const list_view>;
+                using create_cell_callback_t = bbb::opt_arg_function<view::ref()>;
+                using bind_cell_callback_t = bbb::opt_arg_function<void(view::ref, std::size_t)>;
+                
+                static list_view::ref create(float x, float y, float width, float height) {
+                    return create(ofRectangle(x, y, width, height));
+                };
+                
+                static list_view::ref create(const ofRectangle &rect) {
+                    return create(setting{rect});
+                }
+                
+                static list_view::ref create(const setting &setting_) {
+                    auto &&v = make_view<list_view>(setting_);
+                    v->setup();
+                    return v;
+                }
+                
+                inline list_view(const setting &setting_)
+                : scroll_view(setting_) {};
+
+#pragma mark data source
+
+                // called when reuse pool is empty
+                inline void onCreateCell(create_cell_callback_t callback) {
+                    createCellCallback = callback;
+                    // cells made by previous callback aren't reused
+                    recycleAll();
+                    for(auto &&cell : pool) content->remove(cell);
+                    pool.clear();
+                    reloadData();
+                }
+                
+                // configures cell for row. called when a row becomes visible, and by reloadData.
+                inline void onBindCell(bind_cell_callback_t callback) {
+                    bindCellCallback = callback;
+                    reloadData();
+                }
+                
+                inline void setNumberOfRows(std::size_t numRows) {
+                    this->numRows = numRows;
+                    reloadData();
+                }
+                inline std::size_t getNumberOfRows() const { return numRows; };
+                
+                inline void setRowHeight(float rowHeight) {
+                    this->rowHeight = (std::max)(rowHeight, 1.0f);
+                    reloadData();
+                }
+                inline float getRowHeight() const { return rowHeight; };
+                
+                // binds all visible rows again
+                inline void reloadData() {
+                    if(!setupFinished) return;
+                    recycleAll();
+                    setContentSize(getWidth(), rowHeight * numRows);
+                }
+                
+                inline void scrollToRow(std::size_t row)
+                { setContentOffset(ofPoint(getContentOffset().x, rowHeight * row)); };
+                
+                // cell of row if it is visible, otherwise nullptr
+                inline view::ref getCell(std::size_t row) const {
+                    if(row < firstRow || firstRow + cells.size() <= row) return nullptr;
+                    return cells[row - firstRow];
+                }
+                
+                // range of rows having cells: [first, first + num)
+                inline std::size_t getFirstVisibleRow() const { return firstRow; };
+                inline std::size_t getNumVisibleCells() const { return cells.size(); };
+                inline std::size_t getNumPooledCells() const { return pool.size(); };
+            
+            protected:
+                virtual void scrollInternal() override {
+                    if(!setupFinished) return;
+                    const float top = getContentOffset().y;
+                    const std::size_t first = (std::min)(static_cast<std::size_t>(std::floor(top / rowHeight)), numRows);
+                    const std::size_t last = (std::min)(static_cast<std::size_t>(std::ceil((top + getHeight()) / rowHeight)), numRows);
+                    
+                    // recycles cells of rows scrolled out
+                    for(std::size_t i = 0; i < cells.size(); ++i) {
+                        const std::size_t row = firstRow + i;
+                        if(row < first || last <= row) recycle(cells[i]);
+                    }
+                    
+                    // rows already having cell keep it, others take cell from pool
+                    nextCells.clear();
+                    for(std::size_t row = first; row < last; ++row) {
+                        if(firstRow <= row && row < firstRow + cells.size()) {
+                            nextCells.push_back(std::move(cells[row - firstRow]));
+                        } else {
+                            nextCells.push_back(dequeueCell());
+                            bindCell(nextCells.back(), row);
+                        }
+                    }
+                    cells.swap(nextCells);
+                    nextCells.clear();
+                    firstRow = first;
+                    
+                    // follows width
+                    for(auto &&cell : cells) {
+                        if(cell->getFrame().width != getWidth()) cell->setSize(getWidth(), rowHeight);
+                    }
+                }
+                
+                // content follows width, not to be scrolled horizontally
+                virtual void resizeInternal() override {
+                    if(!setupFinished) return;
+                    setContentSize(getWidth(), rowHeight * numRows);
+                }
+                
+                inline void setup() {
+                    scroll_view::setup();
+                    setupFinished = true;
+                    reloadData();
+                }
+                
+            private:
+                inline view::ref dequeueCell() {
+                    if(pool.empty()) {
+                        view::ref cell = createCellCallback();
+                        if(!cell) cell = view::create(ofRectangle());
+                        content->add(cell);
+                        return cell;
+                    }
+                    view::ref cell = std::move(pool.back());
+                    pool.pop_back();
+                    cell->show();
+                    return cell;
+                }
+                
+                inline void bindCell(const view::ref &cell, std::size_t row) {
+                    if(cell->getFrame().width != getWidth() || cell->getFrame().height != rowHeight) cell->setSize(getWidth(), rowHeight);
+                    cell->setPosition(0.0f, rowHeight * row);
+                    bindCellCallback(cell, row);
+                }
+                
+                inline void recycle(view::ref &cell) {
+                    cell->hide();
+                    pool.push_back(std::move(cell));
+                }
+                
+                inline void recycleAll() {
+                    for(auto &&cell : cells) recycle(cell);
+                    cells.clear();
+                    firstRow = 0;
+                }
+                
+                create_cell_callback_t createCellCallback{[] { return view::create(ofRectangle()); }};
+                bind_cell_callback_t bindCellCallback{[](view::ref, std::size_t) {}};
+                
+                std::size_t numRows{0};
+                float rowHeight{44.0f};
+                
+                std::vector<view::ref> cells; // cells[i] is for row firstRow + i
+                std::size_t firstRow{0};
+                std::vector<view::ref> pool;
+                std::vector<view::ref> nextCells;
+                bool setupFinished{false};
+            };
+        }; // components
+    }; // view_system
+    namespace vs = view_system;
+}; // bbb
+
+#endif /* bbb_components_list_view_hpp */
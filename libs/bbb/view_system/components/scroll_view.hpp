@@ -0,0 +1,205 @@
+//
+//  components/scroll_view.hpp
+//
+//  Created by ISHII 2bit on 2018/03/24.
+//
+
+#pragma once
+
+#ifndef bbb_components_scroll_view_hpp
+#define bbb_components_scroll_view_hpp
+
+#include <cmath>
+#include <algorithm>
+
+#include "./view.hpp"
+#include "./event_router.hpp"
+#include "../animation.hpp"
+
+namespace bbb {
+    namespace view_system {
+        inline namespace components {
+            // shows a part of content view, clipped by own bounds.
+            // scrolled by mouse drag or touch, and keeps moving with decaying velocity after release (momentum).
+            // only one touch scrolls at once, others are ignored until it is up.
+            struct scroll_view : public view {
+                using ref = std::shared_ptr<scroll_view>;
+                using const_ref = std::shared_ptr<const scroll_view>;
+                
+                static scroll_view::ref create(float x, float y, float width, float height) {
+                    return create(ofRectangle(x, y, width, height));
+                };
+                
+                static scroll_view::ref create(const ofRectangle &rect) {
+                    return create(setting{rect});
+                }
+                
+                static scroll_view::ref create(const setting &setting_) {
+                    auto &&v = make_view<scroll_view>(setting_);
+                    v->setup();
+                    return v;
+                }
+                
+                inline scroll_view(const setting &setting_)
+                : view(setting_) {};
+
+#pragma mark content
+
+                // subviews of content are scrolled
+                inline view::ref getContentView() const { return content; };
+                
+                inline void setContentSize(float width, float height) {
+                    content->setSize(width, height);
+                    setContentOffset(offset);
+                }
+                inline ofPoint getContentSize() const
+                { return ofPoint(content->getFrame().width, content->getFrame().height); };
+                
+                // clamped into [0, content size - size]
+                inline void setContentOffset(const ofPoint &p) {
+                    const ofPoint maxOffset = getMaxContentOffset();
+                    const ofPoint clamped(ofClamp(p.x, 0.0f, maxOffset.x), ofClamp(p.y, 0.0f, maxOffset.y));
+                    if(clamped != offset) {
+                        offset = clamped;
+                        content->setPosition(-offset.x, -offset.y);
+                    }
+                    scrollInternal();
+                }
+                inline const ofPoint &getContentOffset() const { return offset; };
+                inline ofPoint getMaxContentOffset() const {
+                    const ofPoint size = getContentSize();
+                    return ofPoint((std::max)(size.x - getWidth(), 0.0f), (std::max)(size.y - getHeight(), 0.0f));
+                }
+
+#pragma mark momentum
+
+                inline void setMomentumEnabled(bool isMomentumEnabled) { this->isMomentumEnabled = isMomentumEnabled; };
+                inline bool isEnabledMomentum() const { return isMomentumEnabled; };
+                
+                // time constant of velocity decay, in seconds
+                inline void setDecelerationTime(float decelerationTime) { this->decelerationTime = decelerationTime; };
+                inline float getDecelerationTime() const { return decelerationTime; };
+                
+                inline bool isScrolling() const { return isDragging || animation::manager::get().isRunning(momentum); };
+                inline void stopScrolling() {
+                    animation::manager::get().remove(momentum);
+                    isDragging = false;
+                }
+            
+            protected:
+                // called after content offset is set. (including case of same offset)
+                virtual void scrollInternal() {};
+                
+                virtual void drawInternal() override {
+                    // follows size changed by layout or resize
+                    if(lastSize.x != getWidth() || lastSize.y != getHeight()) {
+                        lastSize.set(getWidth(), getHeight());
+                        resizeInternal();
+                    }
+                };
+                
+                // called by draw when size was changed since last draw
+                virtual void resizeInternal() {
+                    setContentOffset(offset);
+                };
+                
+                // scroll_view is ancestor of hit view (capture phase), or hit view itself
+                virtual void mouseInternal(const mouse_event_arg &arg) override {
+                    switch(arg.type) {
+                        case mouse_event_type::down:
+                            beginDrag(false);
+                            break;
+                        case mouse_event_type::drag:
+                            if(!isTouchDragging) drag(arg.delta);
+                            break;
+                        case mouse_event_type::up:
+                            if(!isTouchDragging) endDrag();
+                            break;
+                        default:
+                            break;
+                    }
+                }
+                
+                virtual void touchInternal(const touch_event_arg &arg) override {
+                    if(arg.type == touch_event_type::down) {
+                        if(!isDragging || !isTouchDragging || arg.id == dragTouchId) beginDrag(true, arg.id);
+                    } else if(isDragging && isTouchDragging && arg.id == dragTouchId) {
+                        if(arg.type == touch_event_type::move) drag(arg.delta);
+                        else endDrag();
+                    }
+                }
+                
+                // called by create, because shared_from_this isn't available in constructor
+                inline void setup() {
+                    setClipSubviews(true);
+                    content = view::create(0.0f, 0.0f, getWidth(), getHeight());
+                    content->setEventTransparentness(true);
+                    add(content);
+                    lastSize.set(getWidth(), getHeight());
+                }
+                
+                view::ref content;
+            
+            private:
+                inline void beginDrag(bool byTouch, int touchId = 0) {
+                    stopScrolling();
+                    isDragging = true;
+                    isTouchDragging = byTouch;
+                    dragTouchId = touchId;
+                    velocity.set(0.0f, 0.0f);
+                    pendingDelta.set(0.0f, 0.0f);
+                    lastDragTime = animation::manager::get().now();
+                    if(!byTouch) capturePointer();
+                }
+                
+                inline void drag(const ofPoint &delta) {
+                    if(!isDragging) return;
+                    setContentOffset(offset - delta);
+                    
+                    // velocity is estimated per animation frame, so moves in same frame are summed
+                    pendingDelta += delta;
+                    const float now = animation::manager::get().now();
+                    const float dt = now - lastDragTime;
+                    if(0.0f < dt) {
+                        velocity = velocity * 0.2f + pendingDelta * (0.8f / dt);
+                        pendingDelta.set(0.0f, 0.0f);
+                        lastDragTime = now;
+                    }
+                }
+                
+                inline void endDrag() {
+                    if(!isDragging) return;
+                    isDragging = false;
+                    // pointer stopped before release
+                    if(0.1f < animation::manager::get().now() - lastDragTime) velocity.set(0.0f, 0.0f);
+                    if(!isMomentumEnabled || std::hypot(velocity.x, velocity.y) < 1.0f || decelerationTime <= 0.0f) return;
+                    
+                    // offset(t) = start - v * tau * (1 - exp(-t / tau))
+                    const ofPoint start = offset, v = velocity;
+                    const float tau = decelerationTime, duration = 6.0f * tau;
+                    momentum = animate([this, start, v, tau, duration](float progress) {
+                        const float t = progress * duration;
+                        setContentOffset(start - v * (tau * (1.0f - std::exp(-t / tau))));
+                    }, duration);
+                }
+                
+                ofPoint offset;
+                ofPoint lastSize;
+                
+                bool isMomentumEnabled{true};
+                float decelerationTime{0.325f};
+                animation::handle momentum;
+                
+                bool isDragging{false};
+                bool isTouchDragging{false};
+                int dragTouchId{0};
+                ofPoint velocity;
+                ofPoint pendingDelta;
+                float lastDragTime{0.0f};
+            };
+        }; // components
+    }; // view_system
+    namespace vs = view_system;
+}; // bbb
+
+#endif /* bbb_components_scroll_view_hpp */
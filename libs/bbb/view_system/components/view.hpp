@@ -10,14 +10,24 @@
 #define bbb_components_view_hpp
 
 #include <map>
+#include <unordered_map>
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <functional>
+#include <typeinfo>
 
 #include "./events.hpp"
 #include "./type_utils.hpp"
 #include "../layout.hpp"
+#include "../arena.hpp"
 #include "../animation.hpp"
+#include "../easing.hpp"
+#include "../easing_table.hpp"
+#include "../tween.hpp"
+#include "../spatial_index.hpp"
+#include "../background_batch.hpp"
+#include "../scissor.hpp"
 
 #include "../opt_arg_function.hpp"
 
@@ -28,21 +38,79 @@
 
 namespace bbb {
     namespace view_system {
+        namespace tween {
+            // properties of view for typed tweens. see tween.hpp
+            namespace property {
+                struct position {
+                    using target_type = view;
+                    using value_type = ofPoint;
+                    static inline std::string label(const view &v);
+                    static inline value_type get(const view &v);
+                    static inline void set(view &v, const value_type &value);
+                    static inline value_type interpolate(const value_type &from, const value_type &to, float t)
+                    { return from + (to - from) * t; };
+                };
+                struct size {
+                    using target_type = view;
+                    using value_type = ofVec2f;
+                    static inline std::string label(const view &v);
+                    static inline value_type get(const view &v);
+                    static inline void set(view &v, const value_type &value);
+                    static inline value_type interpolate(const value_type &from, const value_type &to, float t)
+                    { return from + (to - from) * t; };
+                };
+                struct alpha {
+                    using target_type = view;
+                    using value_type = float;
+                    static inline std::string label(const view &v);
+                    static inline value_type get(const view &v);
+                    static inline void set(view &v, const value_type &value);
+                    static inline value_type interpolate(const value_type &from, const value_type &to, float t)
+                    { return from + (to - from) * t; };
+                };
+                struct background_color {
+                    using target_type = view;
+                    using value_type = ofFloatColor;
+                    static inline std::string label(const view &v);
+                    static inline value_type get(const view &v);
+                    static inline void set(view &v, const value_type &value);
+                    static inline value_type interpolate(const value_type &from, const value_type &to, float t)
+                    { return from.getLerped(to, t); };
+                };
+                struct margin {
+                    using target_type = view;
+                    using value_type = layout::margin;
+                    static inline std::string label(const view &v);
+                    static inline value_type get(const view &v);
+                    static inline void set(view &v, const value_type &value);
+                    static inline value_type interpolate(const value_type &from, const value_type &to, float t) {
+                        return {
+                            from.top + (to.top - from.top) * t,
+                            from.right + (to.right - from.right) * t,
+                            from.bottom + (to.bottom - from.bottom) * t,
+                            from.left + (to.left - from.left) * t
+                        };
+                    };
+                };
+            };
+        };
+        
         inline namespace components {
             template <bool b, typename t>
             using enable_if_t = typename std::enable_if<b, t>::type;
             
             template <typename view_type>
             static inline std::shared_ptr<view_type> create(const typename view_type::setting &setting) {
-                return std::make_shared<view_type>(setting);
+                return make_view<view_type>(setting);
             }
             
             namespace { // make static
                 void mouse_default(mouse_event_arg);
+                void touch_default(touch_event_arg);
                 void resized_default(resized_event_arg arg);
                 void fitToParent(resized_event_arg arg);
             }
-
+            
             struct view : public std::enable_shared_from_this<view> {
                 using ref = std::shared_ptr<view>;
                 using const_ref = std::shared_ptr<const view>;
@@ -60,7 +128,7 @@ namespace bbb {
                     struct is_family : std::false_type {};
                     template <typename _>
                     struct is_family<setting_base<_>> : std::true_type {};
-
+                    
                     using self_type = type_utils::return_type_t<type, setting_base>;
                     inline self_type &self() { return reinterpret_cast<self_type &>(*this); };
                     
@@ -71,7 +139,7 @@ namespace bbb {
                     template <typename _>
                     operator const setting_base<_>&() const
                     { return reinterpret_cast<const setting_base<_> &>(*this); };
-
+                    
                     inline setting_base(float x, float y,
                                         float width, float height,
                                         const layout::margin &margin = {})
@@ -124,6 +192,10 @@ namespace bbb {
                         this->isResizable = isResizable;
                         return self();
                     }
+                    inline self_type &setClipSubviews(bool isClippingSubviews) {
+                        this->isClippingSubviews = isClippingSubviews;
+                        return self();
+                    }
                     
                     ofRectangle frame{0.0f, 0.0f, 0.0f, 0.0f};
                     layout::margin margin{0.0f};
@@ -134,6 +206,7 @@ namespace bbb {
                     bool isEventTransparent{false};
                     bool isEnabledUserInteraction{true};
                     bool isResizable{false};
+                    bool isClippingSubviews{false};
                 };
                 struct traits {
                     template <typename type>
@@ -182,7 +255,7 @@ namespace bbb {
                     using type = traits::remove_shared_ptr_t<inherited_view_ref>;
                     return std::dynamic_pointer_cast<type>(shared_from_this());
                 };
-
+                
                 using setting = setting_base<void>;
                 
                 static view::ref create(float x, float y, float width, float height) {
@@ -195,34 +268,38 @@ namespace bbb {
                 
                 template <typename _>
                 static view::ref create(const setting_base<_> &setting_ = {}) {
-                    return std::make_shared<view>(setting_);
+                    return make_view<view>(setting_);
                 }
-
+                
                 inline view() = default;
                 
                 inline view(const setting &setting_)
                 : setting_(setting_)
                 , position(setting_.frame.position)
-                , name("view_" + std::to_string(rand()))
                 { calculateLayout(); };
                 
                 inline view(setting &&setting_)
                 : setting_(std::move(setting_))
-                , position(setting_.frame.position)
-                , name("view_" + std::to_string(rand()))
+                , position(this->setting_.frame.position)
                 { calculateLayout(); };
                 
                 virtual ~view() {
-                    unregisterEvents();
+                    cancelOwnAnimations();
+                    forgetEvents();
+                    forgetFrameChange();
                 };
                 
-                inline setting &getSetting() { return setting_; }
+                // read only. use setters or setSetting to modify, so cached values are invalidated.
                 inline const setting &getSetting() const { return setting_; }
                 
                 inline void setSetting(const setting &setting_) {
                     this->position = setting_.frame.position;
                     this->setting_ = setting_;
                     calculateLayout();
+                    invalidate(dirty_flags::all);
+                    hitTestChanged();
+                    // visibility can be changed
+                    if(auto p = parent.lock()) p->boundsChanged();
                 };
                 
                 template <typename setting_t>
@@ -237,32 +314,35 @@ namespace bbb {
                     if(v->parent.lock()) v->parent.lock()->remove(v);
                     remove(name);
                     
-                    v->name = name;
+                    v->setName(name);
                     v->parent = shared_from_this();
-                    subviews.emplace_back(v);
+                    v->invalidate(dirty_flags::all);
+                    insertSubview(subviews.end(), v);
                 }
                 
                 inline void add(view::ref v) {
                     if(v->parent.lock()) v->parent.lock()->remove(v);
                     
                     v->parent = shared_from_this();
-                    subviews.emplace_back(v);
+                    v->invalidate(dirty_flags::all);
+                    insertSubview(subviews.end(), v);
                 }
                 
                 inline void insert_view_to_front_of(const std::string &name, view::ref v, view::ref target) {
                     if(v->parent.lock()) v->parent.lock()->remove(v);
                     remove(name);
                     
-                    v->name = name;
+                    v->setName(name);
                     v->parent = shared_from_this();
+                    v->invalidate(dirty_flags::all);
                     
                     auto end = subviews.end();
                     auto it = std::find(subviews.begin(), end, target);
                     if(it == end) {
                         ofLogWarning() << "can't find target from " << subviews.size() << "subview(s)";
-                        subviews.emplace_back(v);
+                        insertSubview(subviews.end(), v);
                     } else {
-                        subviews.insert(it + 1, v);
+                        insertSubview(it + 1, v);
                     }
                 }
                 inline void insert_view_to_front_of(const std::string &name, view::ref v, const std::string &target_name)
@@ -271,33 +351,35 @@ namespace bbb {
                 inline void insert_view_to_front_of(view::ref v, view::ref target) {
                     if(v->parent.lock()) v->parent.lock()->remove(v);
                     v->parent = shared_from_this();
+                    v->invalidate(dirty_flags::all);
                     
                     auto end = subviews.end();
                     auto it = std::find(subviews.begin(), end, target);
                     if(it == end) {
                         ofLogWarning() << "can't find target from " << subviews.size() << "subview(s)";
-                        subviews.emplace_back(v);
+                        insertSubview(subviews.end(), v);
                     } else {
-                        subviews.insert(it + 1, v);
+                        insertSubview(it + 1, v);
                     }
                 }
                 inline void insert_view_to_front_of(view::ref v, const std::string &target_name)
                 { insert_view_to_front_of(v, find(target_name)); };
-
+                
                 inline void insert_view_to_rear_of(const std::string &name, view::ref v, view::ref target) {
                     if(v->parent.lock()) v->parent.lock()->remove(v);
                     remove(name);
                     
-                    v->name = name;
+                    v->setName(name);
                     v->parent = shared_from_this();
+                    v->invalidate(dirty_flags::all);
                     
                     auto end = subviews.end();
                     auto it = std::find(subviews.begin(), end, target);
                     if(it == end) {
                         ofLogWarning() << "can't find target from " << subviews.size() << "subview(s)";
-                        subviews.emplace_back(v);
+                        insertSubview(subviews.end(), v);
                     } else {
-                        subviews.insert(it, v);
+                        insertSubview(it, v);
                     }
                 }
                 inline void insert_view_to_rear_of(const std::string &name, view::ref v, const std::string &target_name)
@@ -306,14 +388,15 @@ namespace bbb {
                 inline void insert_view_to_rear_of(view::ref v, view::ref target) {
                     if(v->parent.lock()) v->parent.lock()->remove(v);
                     v->parent = shared_from_this();
+                    v->invalidate(dirty_flags::all);
                     
                     auto end = subviews.end();
                     auto it = std::find(subviews.begin(), end, target);
                     if(it == end) {
                         ofLogWarning() << "can't find target from " << subviews.size() << "subview(s)";
-                        subviews.emplace_back(v);
+                        insertSubview(subviews.end(), v);
                     } else {
-                        subviews.insert(it, v);
+                        insertSubview(it, v);
                     }
                 }
                 
@@ -321,30 +404,17 @@ namespace bbb {
                 { insert_view_to_rear_of(v, find(target_name)); };
                 
                 inline view::ref find(const std::string &name) const {
-                    auto &&result = std::find_if(subviews.begin(), subviews.end(), [&](view::ref v) {
-                        return v->name == name;
-                    });
-                    return (result == subviews.end()) ? view::ref() : *result;
+                    const view *v = findByName(name);
+                    return v ? subviews[v->siblingIndex_] : view::ref();
                 }
                 
                 inline void remove(const std::string &name) {
-                    auto &&eraser = std::remove_if(subviews.begin(), subviews.end(), [&](view::ref v) {
-                        return v->name == name;
-                    });
-                    auto &&end = subviews.end();
-                    std::for_each(eraser, end, [](view::ref v) {
-//                        if(v->parent.lock()) v->parent.reset();
-                    });
-                    subviews.erase(eraser, end);
+                    while(const view *v = findByName(name)) eraseSubview(subviews.begin() + v->siblingIndex_);
                 }
                 
                 inline void remove(const view::ref &v) {
-                    auto &&eraser = std::remove(subviews.begin(), subviews.end(), v);
-                    auto &&end = subviews.end();
-//                    std::for_each(eraser, end, [](view::ref v) {
-//                        if(v && v->parent.lock()) v->parent.reset();
-//                    });
-                    subviews.erase(eraser, end);
+                    auto &&it = std::find(subviews.begin(), subviews.end(), v);
+                    if(it != subviews.end()) eraseSubview(it);
                 }
                 
                 inline void removeFromParent() {
@@ -356,24 +426,53 @@ namespace bbb {
                 inline void setOrigin(float x, float y) {
                     position.x = x;
                     position.y = y;
+                    invalidate(dirty_flags::global_origin);
+                    frameChanged();
                 }
                 inline void setOrigin(const ofPoint &p) { setOrigin(p.x, p.y); }
                 
                 inline bool isShown() const { return getSetting().isVisible; };
-                inline void setVisible(bool isVisible) { getSetting().isVisible = isVisible; };
+                inline void setVisible(bool isVisible) {
+                    if(setting_.isVisible == isVisible) return;
+                    setting_.isVisible = isVisible;
+                    hitTestChanged();
+                    boundsChanged();
+                    // hidden view isn't measured by getSubtreeBounds, so it can be dirty under clean parent
+                    if(auto p = parent.lock()) {
+                        p->boundsChanged();
+                        p->subviewLayoutChanged();
+                    }
+                };
+                // tweens a property with typed tween. running tween of same property is replaced.
+                template <typename property>
+                inline void tweenTo(const typename property::value_type &to,
+                                    float duration,
+                                    easing::curve easing = easing::type::linear,
+                                    float delay = 0.0f,
+                                    bbb::opt_arg_function<void(const std::string &)> finish = [](const std::string &) {})
+                {
+                    tween::to<property>(this, to, duration, easing, delay, finish);
+                }
+                
+                // animation owned by this view. it is cancelled by cancelAnimations or destruction of this view.
+                inline animation::handle animate(animation::callback_t callback,
+                                                 float duration,
+                                                 float delay = 0.0f,
+                                                 animation::finish_callback_t finish = [](const std::string &) {})
+                {
+                    return animation::manager::get().add(std::move(callback), duration, delay, std::string(), std::move(finish), id_);
+                }
+                
+                // cancels animations owned by this view and its tweens, without finish callbacks.
+                inline void cancelAnimations(bool recursive = false) {
+                    cancelOwnAnimations();
+                    if(recursive) for(auto &&v : subviews) v->cancelAnimations(true);
+                }
+                
                 inline void fadeTo(float alpha,
                                    float duration = 0.3f,
                                    bbb::opt_arg_function<void(const std::string &)> finish = [](const std::string &) {})
-                {
-                    const std::string animation_name = getName() + "::fade_animation";
-                    const float current_alpha = getAlpha();
-                    animation::remove(animation_name);
-                    animation::add([=](float p) {
-                        setAlpha(bbb::pmap(p, current_alpha, alpha));
-                    }, duration, animation_name, [=](const std::string &label) {
-                        finish(label);
-                    });
-                };
+                { tweenTo<tween::property::alpha>(alpha, duration, easing::type::linear, 0.0f, finish); };
                 inline void show() { setVisible(true); };
                 inline void fadeIn(float duration, bbb::opt_arg_function<void(const std::string &)> finish = [](const std::string &) {}) {
                     show();
@@ -393,29 +492,51 @@ namespace bbb {
                 };
                 inline bool setEnableResize(bool isResizable) {
                     ofLogWarning() << "feature of resizing: not implemented";
-                    return getSetting().isResizable = isResizable;
+                    return setting_.isResizable = isResizable;
                 };
                 
                 inline void setEventTransparentness(bool isEventTransparent) {
-                    getSetting().isEventTransparent = isEventTransparent;
+                    setting_.isEventTransparent = isEventTransparent;
+                    hitTestChanged();
                 }
                 inline bool isEventTransparent() const { return getSetting().isEventTransparent; };
                 
+                inline bool isClippingSubviews() const { return getSetting().isClippingSubviews; };
+                inline void setClipSubviews(bool isClippingSubviews) {
+                    setting_.isClippingSubviews = isClippingSubviews;
+                    hitTestChanged();
+                };
+                
                 inline bool isEnabledUserInteraction() const { return getSetting().isEnabledUserInteraction; };
-                inline void enableUserInteraction() { getSetting().isEnabledUserInteraction = true; };
-                inline void disableUserInteraction() { getSetting().isEnabledUserInteraction = false; };
+                inline void enableUserInteraction() {
+                    setting_.isEnabledUserInteraction = true;
+                    hitTestChanged();
+                };
+                inline void disableUserInteraction() {
+                    setting_.isEnabledUserInteraction = false;
+                    hitTestChanged();
+                };
                 
                 inline bool isClickedNow() const { return isClickedNow_; };
                 
-                inline ofPoint convertToLocalCoordinate(ofPoint p = ofPoint()) const {
-                    for(auto v = this; v != nullptr; v = v->parent.lock().get()) p -= v->position - ofPoint(v->getSetting().margin.left, v->getSetting().margin.top);
-                    return p;
+                // subviews are indexed by their subtree bounds, so hit-testing gives same result as without index.
+                inline void enableSpatialIndex(float cellSize = 64.0f) {
+                    disableSpatialIndex();
+                    subviewIndex_.reset(new uniform_grid<view>(cellSize));
+                    for(auto &&v : subviews) subviewIndex_->insert(v.get(), v->subtreeBoundsInParent(), isFrontOf);
                 }
-                
-                inline ofPoint convertToGlobalCoordinate(ofPoint p = ofPoint()) const {
-                    for(auto v = this; v != nullptr; v = v->parent.lock().get()) p += v->position + ofPoint(v->getSetting().margin.left, v->getSetting().margin.top);
-                    return p;
+                inline void disableSpatialIndex() {
+                    for(auto &&v : pendingIndexUpdates_) v->isIndexEntryDirty_ = false;
+                    pendingIndexUpdates_.clear();
+                    subviewIndex_.reset();
                 }
+                inline bool isEnabledSpatialIndex() const { return static_cast<bool>(subviewIndex_); };
+                
+                inline ofPoint convertToLocalCoordinate(const ofPoint &p = ofPoint()) const
+                { return p - globalOrigin(); }
+                
+                inline ofPoint convertToGlobalCoordinate(const ofPoint &p = ofPoint()) const
+                { return p + globalOrigin(); }
                 
                 inline void onClickDown(bbb::opt_arg_function<void(mouse_event_arg)> callback) {
                     clickDownCallback = callback;
@@ -429,87 +550,194 @@ namespace bbb {
                     mouseOverCallback = callback;
                 }
                 
+                // called while pointer is dragged after pressed on this view (or this view captured pointer)
+                inline void onDrag(bbb::opt_arg_function<void(mouse_event_arg)> callback) {
+                    draggedCallback = callback;
+                }
+                
+                // touches are dispatched to target view, then bubble up to its ancestors
+                inline void onTouchDown(bbb::opt_arg_function<void(touch_event_arg)> callback) {
+                    touchDownCallback = callback;
+                }
+                
+                inline void onTouchMove(bbb::opt_arg_function<void(touch_event_arg)> callback) {
+                    touchMovedCallback = callback;
+                }
+                
+                inline void onTouchUp(bbb::opt_arg_function<void(touch_event_arg)> callback) {
+                    touchUpCallback = callback;
+                }
+                
+                // number of touches targeting this view
+                inline std::size_t getNumTouches() const { return numTouches_; };
+                inline bool isTouchedNow() const { return 0 < numTouches_; };
+                
+                // called once when pointer comes into / goes out of this view
+                inline void onMouseEnter(bbb::opt_arg_function<void(mouse_event_arg)> callback) {
+                    mouseEnterCallback = callback;
+                }
+                
+                inline void onMouseLeave(bbb::opt_arg_function<void(mouse_event_arg)> callback) {
+                    mouseLeaveCallback = callback;
+                }
+                
+                // called in capture phase of mouse events (arg.type) hitting subviews of this view
+                inline void onMouseCapture(bbb::opt_arg_function<void(mouse_event_arg)> callback) {
+                    mouseCaptureCallback = callback;
+                }
+                
                 inline void onWindowResized(bbb::opt_arg_function<void(resized_event_arg)> callback) {
                     windowResizedCallback = callback;
                 }
                 
                 inline bool isInside(const ofPoint &p) const {
-                    auto &margin = getSetting().margin;
-                    return ofRectangle(topLeft() + ofPoint(margin.left, margin.top), width - (margin.left + margin.right), height + (margin.top - margin.bottom)).inside(p);
+                    return hitRect(topLeft()).inside(p);
                 }
                 
                 template <typename integer_t>
                 inline auto setBackgroundColor(integer_t r, integer_t g, integer_t b, integer_t a = 255)
                 -> typename std::enable_if<std::is_integral<integer_t>::value>::type
                 {
-                    getSetting().backgroundColor.set(r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f);
+                    setting_.backgroundColor.set(r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f);
                 }
                 inline void setBackgroundColor(float r, float g, float b, float a = 1.0f) {
-                    getSetting().backgroundColor.set(r, g, b, a);
+                    setting_.backgroundColor.set(r, g, b, a);
                 }
                 inline void setBackgroundColor(const ofFloatColor &c) { setBackgroundColor(c.r, c.g, c.b, c.a); };
                 inline void setBackgroundColor(const ofColor &c) { setBackgroundColor(c.r, c.g, c.b, c.a); };
                 
-                inline ofFloatColor &getBackgroundColor() { return getSetting().backgroundColor; };
+                inline ofFloatColor &getBackgroundColor() { return setting_.backgroundColor; };
                 inline const ofFloatColor &getBackgroundColor() const { return getSetting().backgroundColor; };
                 
-                inline float getParentAlpha() const { return getParent().get() ? getParent()->getAlpha() : 1.0f; };
-                inline float getAlpha() const { return getParentAlpha() * getSetting().alpha; };
+                inline float getParentAlpha() const {
+                    auto &&p = parent.lock();
+                    return p ? p->getAlpha() : 1.0f;
+                };
+                inline float getAlpha() const {
+                    if(dirtyFlags_ & dirty_flags::alpha) {
+                        effectiveAlpha_ = getParentAlpha() * setting_.alpha;
+                        dirtyFlags_ &= ~dirty_flags::alpha;
+                    }
+                    return effectiveAlpha_;
+                };
                 inline float calcAlpha(float alpha = 1.0f) const { return getParentAlpha() * alpha; };
                 template <typename float_t>
                 inline auto setAlpha(float_t alpha)
                 -> typename std::enable_if<std::is_floating_point<float_t>::value>::type
-                { getSetting().alpha = alpha; };
+                {
+                    setting_.alpha = alpha;
+                    invalidate(dirty_flags::alpha);
+                };
                 template <typename int_t>
                 inline auto setAlpha(int_t alpha)
                 -> typename std::enable_if<std::is_integral<int_t>::value>::type
-                { getSetting().alpha = alpha / 255.0f; };
-
-                inline const std::string &getName() const & { return name; };
-                inline std::string &&getName() && { return std::move(name); };
+                { setAlpha(alpha / 255.0f); };
                 
-                inline ofPoint &getPosition() { return position; };
+                inline std::uint64_t getId() const { return id_; };
+                // unnamed view is called "view_<id>". the string is built at first request.
+                inline const std::string &getName() const & {
+                    if(name.empty()) name = "view_" + std::to_string(id_);
+                    return name;
+                };
+                inline std::string &&getName() && {
+                    getName();
+                    return std::move(name);
+                };
+                
+                // read only. modifications go through setPosition / moveTo etc. to keep cached coordinates valid.
                 inline ofPoint getPosition() const { return position; };
-                inline void setPosition(float x, float y) { position.set(x, y); }
-                inline void setPosition(const ofPoint &p) { position = p; }
-                inline void moveTo(const ofPoint &p) { position = p; }
-                inline void moveTo(float x, float y) { position.set(x, y); }
-                inline void move(const ofPoint &p) { position += p; }
-                inline void move(float x, float y) { position.x += x, position.y += y; }
+                inline void setPosition(float x, float y) { setOrigin(x, y); }
+                inline void setPosition(const ofPoint &p) { setOrigin(p.x, p.y); }
+                inline void moveTo(const ofPoint &p) { setOrigin(p.x, p.y); }
+                inline void moveTo(float x, float y) { setOrigin(x, y); }
+                inline void move(const ofPoint &p) { setOrigin(position.x + p.x, position.y + p.y); }
+                inline void move(float x, float y) { setOrigin(position.x + x, position.y + y); }
                 
                 inline const ofRectangle &getFrame() const { return setting_.frame; };
                 inline ofRectangle getBounds() const { return {0, 0, width, height}; };
                 
                 inline float getWidth() const { return width; };
                 inline void setWidth(float width) {
-                    getSetting().frame.width = width;
+                    setting_.frame.width = width;
                     calculateLayout();
                 }
                 
                 inline float getHeight() const { return height; };
                 inline void setHeight(float height) {
-                    getSetting().frame.height = height;
+                    setting_.frame.height = height;
                     calculateLayout();
                 };
                 
                 inline void setSize(float width, float height) {
-                    getSetting().frame.width = width;
-                    getSetting().frame.height = height;
+                    setting_.frame.width = width;
+                    setting_.frame.height = height;
                     calculateLayout();
                 }
                 
                 inline void calculateLayout() {
-                    auto &margin = getSetting().margin;
-                    width = getSetting().frame.width - margin.right - margin.left;
-                    height = getSetting().frame.height - margin.top - margin.bottom;
+                    auto &margin = setting_.margin;
+                    width = setting_.frame.width - margin.right - margin.left;
+                    height = setting_.frame.height - margin.top - margin.bottom;
+                    frameChanged();
+                    if(isArrangingLayout()) {
+                        // resized by parent's layout
+                        isArrangeDirty_ = true;
+                        markLayoutPath();
+                    } else {
+                        preferredSize_.set(setting_.frame.width, setting_.frame.height);
+                        layoutChanged();
+                    }
+                }
+                
+#pragma mark layout
+                
+                // subviews are arranged by params of this view (as container) and params of them (as item).
+                // only subtrees changed after last updateLayout are measured and arranged again.
+                inline void setLayout(const layout::params &params) {
+                    layoutParams_ = params;
+                    layoutChanged();
+                }
+                inline const layout::params &getLayout() const { return layoutParams_; };
+                
+                // called from draw, so it is needed to call explicitly only for reading result before drawing.
+                inline void updateLayout() {
+                    if(!hasDirtyLayout_) return;
+                    if(layoutParams_.isFittingContent && layoutParams_.isStacking() && !isArrangedByParent()) {
+                        const ofPoint &size = measure();
+                        setFrameByLayout(position.x, position.y, size.x, size.y);
+                    }
+                    if(isArrangeDirty_) {
+                        isArrangeDirty_ = false;
+                        arrangeSubviews();
+                    }
+                    for(auto &&v : subviews) v->updateLayout();
+                    hasDirtyLayout_ = false;
+                }
+                
+                // preferred size of frame: given frame, or content size if isFittingContent
+                inline const ofPoint &measure() {
+                    if(isMeasureDirty_) {
+                        isMeasureDirty_ = false;
+                        if(layoutParams_.isFittingContent && layoutParams_.isStacking()) {
+                            collectLayoutItems();
+                            float w, h;
+                            layout::measure(layoutParams_, layoutItems(), w, h);
+                            auto &margin = setting_.margin;
+                            measuredSize_.set(w + margin.left + margin.right, h + margin.top + margin.bottom);
+                        } else {
+                            measuredSize_ = preferredSize_;
+                        }
+                    }
+                    return measuredSize_;
                 }
                 
                 inline void setMargin(float margin) { setMargin(margin, margin, margin, margin); };
                 inline void setMargin(float vertical, float horizontal) { setMargin(vertical, horizontal, vertical, horizontal); };
                 inline void setMargin(float top, float h, float bottom) { setMargin(top, h, bottom, h); };
                 inline void setMargin(float top, float right, float bottom, float left) {
-                    getSetting().margin.set(top, right, bottom, left);
+                    setting_.margin.set(top, right, bottom, left);
                     calculateLayout();
+                    invalidate(dirty_flags::global_origin);
                 };
                 
                 inline view::ref getParent() { return parent.lock(); };
@@ -519,34 +747,34 @@ namespace bbb {
                 inline auto getSubviewAs(const std::string &name)
                     -> decltype(find(name)->as<type>())
                 { return find(name)->as<type>(); };
-
-                inline float left() const { return convertToGlobalCoordinate().x; };
+                
+                inline float left() const { return globalOrigin().x; };
                 inline float right() const { return left() + width; };
-                inline float top() const { return convertToGlobalCoordinate().y; };
+                inline float top() const { return globalOrigin().y; };
                 inline float bottom() const { return top() + height; };
                 
-                inline void setLeft(float left) { getPosition().x = left; };
-                inline void setRight(float right) { getPosition().x = right - getWidth(); };
-                inline void setTop(float top) { getPosition().y = top; };
-                inline void setBottom(float bottom) { getPosition().y = bottom - getHeight(); };
-
+                inline void setLeft(float left) { setOrigin(left, position.y); };
+                inline void setRight(float right) { setOrigin(right - getWidth(), position.y); };
+                inline void setTop(float top) { setOrigin(position.x, top); };
+                inline void setBottom(float bottom) { setOrigin(position.x, bottom - getHeight()); };
+                
                 inline void setLeftStretch(float left) {
-                    float l = getPosition().x;
+                    float l = position.x;
                     setLeft(left);
                     setWidth(getWidth() + l - left);
                 };
                 inline void setRightStretch(float right) {
-                    float r = getPosition().x + getWidth();
+                    float r = position.x + getWidth();
                     setRight(right);
                     setWidth(getWidth() + right - r);
                 };
                 inline void setTopStretch(float top) {
-                    float t = getPosition().y;
+                    float t = position.y;
                     setTop(top);
                     setHeight(getHeight() + t - top);
                 };
                 inline void setBottomStretch(float bottom) {
-                    float b = getPosition().y + getHeight();
+                    float b = position.y + getHeight();
                     setBottom(bottom);
                     setHeight(getHeight() + bottom - b);
                 };
@@ -554,39 +782,192 @@ namespace bbb {
                 inline float horizontalCenter() const { return left() + width * 0.5f; };
                 inline float verticalCenter() const { return top() + height * 0.5f; };
                 
-                inline ofPoint topLeft() const { return convertToGlobalCoordinate(); };
+                inline ofPoint topLeft() const { return globalOrigin(); };
                 inline ofPoint topRight() const { return topLeft() + ofPoint(width, 0); };
                 inline ofPoint bottomLeft() const { return topLeft() + ofPoint(0, height); };
                 inline ofPoint bottomRight() const { return topLeft() + ofPoint(width, height); };
                 inline ofPoint center() const { return topLeft() + ofPoint(width * 0.5f, height * 0.5f); };
                 
-                virtual void draw() {
-                    if(!isShown()) return;
-                    pushState();
-                    ofTranslate(position + ofPoint(getSetting().margin.left, getSetting().margin.top));
-                    drawBackground();
-                    drawInternal();
-                    drawSubviews();
-                    popState();
+                struct culling_stats {
+                    std::size_t drawn{0};
+                    std::size_t culled{0};
+                    std::uint64_t frame{0};
+                };
+                // counts of views drawn / skipped by culling in current frame
+                static inline const culling_stats &getCullingStats() { return cullingStats(); };
+                
+                // visible area is assumed as window. tree is assumed to be drawn without extra transform.
+                // NOTE: not virtual. subclasses customize drawing by drawInternal, or by drawTree for whole subtree.
+                inline void draw() { draw(ofGetWindowRect()); }
+                
+                // visibleRect: area where this tree appears, in global coordinate
+                inline void draw(const ofRectangle &visibleRect) {
+                    updateLayout();
+                    beginCullingFrame();
+                    drawTree(visibleRect);
+                }
+                
+                // bounds of this view and visible subviews, in this view's local coordinate
+                inline const ofRectangle &getSubtreeBounds() const {
+                    if(isBoundsDirty_) {
+                        subtreeBounds_.set(0.0f, 0.0f, width, height);
+                        subtreeBounds_.growToInclude(hitRect());
+                        subtreeSize_ = 1;
+                        for(auto &&v : subviews) {
+                            if(!v->isShown()) continue;
+                            ofRectangle r = v->getSubtreeBounds();
+                            r.translate(v->localOrigin());
+                            subtreeBounds_.growToInclude(r);
+                            subtreeSize_ += v->subtreeSize_;
+                        }
+                        isBoundsDirty_ = false;
+                    }
+                    return subtreeBounds_;
+                }
+                inline ofRectangle getGlobalSubtreeBounds() const {
+                    ofRectangle r = getSubtreeBounds();
+                    r.translate(globalOrigin());
+                    return r;
+                }
+                
+                // draws backgrounds of whole tree by batch. batch is flushed only before custom drawing.
+                // culled same as draw(visibleRect). backgrounds of subviews of clipping view are cut by its frame,
+                // and custom drawing is clipped by scissor.
+                // NOTE: overridden drawTree of subviews isn't called in this mode.
+                inline void drawBatched(background_batch &batch, const ofRectangle &visibleRect) {
+                    updateLayout();
+                    beginCullingFrame();
+                    appendToBatch(batch, visibleRect, false, true);
+                    batch.flush();
+                }
+                inline void drawBatched(background_batch &batch) { drawBatched(batch, ofGetWindowRect()); };
+                inline void drawBatched() {
+                    static background_batch batch;
+                    drawBatched(batch);
+                }
+                
+                // collects backgrounds only, culled and clipped as drawBatched. doesn't draw anything.
+                inline void buildBackgroundBatch(background_batch &batch, const ofRectangle &visibleRect) const {
+                    const_cast<view *>(this)->appendToBatch(batch, visibleRect, false, false);
+                }
+                inline void buildBackgroundBatch(background_batch &batch) const
+                { buildBackgroundBatch(batch, ofGetWindowRect()); };
+                
+                // registers this view as root of event_router. (defined in event_router.hpp)
+                inline void registerEvents();
+                inline void unregisterEvents();
+                inline bool isRegisteredEvents() const { return isEventRoot_; };
+                
+                // pressed view captures pointer by default, and receives drag / up directly.
+                // capturePointer in onClickDown callback nominates this view instead. (defined in event_router.hpp)
+                inline void capturePointer();
+                inline void releasePointerCapture();
+                inline bool hasPointerCapture() const;
+                
+                // appends views hit by p in dispatching order: front to back, subviews before itself.
+                // if stopAtOpaque, stops at first view which is not event transparent and returns true.
+                // if stable is given, it is shrunk to an area around p where the result doesn't change
+                // (until hitTestGeneration() changes, or a view in frameChangedViews() overlaps it).
+                inline bool collectHits(const ofPoint &p, std::vector<view *> &hits, bool stopAtOpaque = true, ofRectangle *stable = nullptr) {
+                    if(!isShown()) return false;
+                    if(stable) {
+                        const ofRectangle bounds = getGlobalSubtreeBounds();
+                        if(!bounds.inside(p)) {
+                            excludeArea(*stable, bounds, p);
+                            return false;
+                        }
+                    } else if(!getGlobalSubtreeBounds().inside(p)) return false;
+                    
+                    if(!canHitSubviews(p)) {
+                        // clipped out
+                        if(stable) excludeArea(*stable, globalFrame(), p);
+                    } else {
+                        if(stable && isClippingSubviews()) *stable = stable->getIntersection(globalFrame());
+                        if(subviewIndex_) {
+                            auto &&candidates = querySubviews(p);
+                            if(stable) {
+                                // subviews out of this cell aren't tested
+                                ofRectangle cell = subviewIndex_->cellRect(convertToLocalCoordinate(p));
+                                cell.translate(globalOrigin());
+                                *stable = stable->getIntersection(cell);
+                            }
+                            for(auto &&subview : candidates) if(subview->collectHits(p, hits, stopAtOpaque, stable)) return true;
+                        } else {
+                            for(auto subview = subviews.rbegin();
+                                subview != subviews.rend();
+                                ++subview) if((*subview)->collectHits(p, hits, stopAtOpaque, stable)) return true;
+                        }
+                    }
+                    if(!isEnabledUserInteraction()) return false;
+                    if(isInside(p)) {
+                        if(stable) *stable = stable->getIntersection(hitRect(topLeft()));
+                        hits.push_back(this);
+                        return stopAtOpaque && !isEventTransparent();
+                    }
+                    if(stable) excludeArea(*stable, hitRect(topLeft()), p);
+                    return false;
                 }
                 
-                void registerEvents() {
-                    auto &&events = ofEvents();
-                    ofAddListener(events.mousePressed, this, &view::mousePressed, OF_EVENT_ORDER_BEFORE_APP);
-                    ofAddListener(events.mouseReleased, this, &view::mouseReleased, OF_EVENT_ORDER_BEFORE_APP);
-                    ofAddListener(events.mouseMoved, this, &view::mouseMoved, OF_EVENT_ORDER_BEFORE_APP);
-                    ofAddListener(events.mouseDragged, this, &view::mouseDragged, OF_EVENT_ORDER_BEFORE_APP);
-                    ofAddListener(events.windowResized, this, &view::windowResizedRoot, OF_EVENT_ORDER_BEFORE_APP);
+                // multi-point version of collectHits, for all points in one traversal.
+                // targets[i] is set to front-most view hit by points[i] which is not event transparent.
+                // only i in pending[begin, end) with null targets[i] are tested. pending is used as stack.
+                inline void findTargets(const std::vector<ofPoint> &points,
+                                        std::vector<view *> &targets,
+                                        std::vector<std::size_t> &pending,
+                                        std::size_t begin,
+                                        std::size_t end)
+                {
+                    if(!isShown()) return;
+                    const ofRectangle bounds = getGlobalSubtreeBounds();
+                    const std::size_t first = pending.size();
+                    for(std::size_t i = begin; i < end; ++i) {
+                        const std::size_t index = pending[i];
+                        if(!targets[index] && bounds.inside(points[index])) pending.push_back(index);
+                    }
+                    const std::size_t last = pending.size();
+                    if(first == last) return;
+                    
+                    // points which can hit subviews
+                    for(std::size_t i = first; i < last; ++i) {
+                        if(canHitSubviews(points[pending[i]])) pending.push_back(pending[i]);
+                    }
+                    const std::size_t subLast = pending.size();
+                    if(subviewIndex_) {
+                        for(std::size_t i = last; i < subLast; ++i) {
+                            const std::size_t index = pending[i];
+                            for(auto &&subview : querySubviews(points[index])) {
+                                if(targets[index]) break;
+                                subview->findTargets(points, targets, pending, i, i + 1);
+                            }
+                        }
+                    } else if(last < subLast) {
+                        for(auto subview = subviews.rbegin();
+                            subview != subviews.rend();
+                            ++subview) (*subview)->findTargets(points, targets, pending, last, subLast);
+                    }
+                    pending.resize(last);
+                    
+                    if(isEnabledUserInteraction() && !isEventTransparent()) {
+                        for(std::size_t i = first; i < last; ++i) {
+                            const std::size_t index = pending[i];
+                            if(!targets[index] && isInside(points[index])) targets[index] = this;
+                        }
+                    }
+                    pending.resize(first);
                 }
                 
-                void unregisterEvents() {
-                    auto &&events = ofEvents();
-                    ofRemoveListener(events.mousePressed, this, &view::mousePressed);
-                    ofRemoveListener(events.mouseReleased, this, &view::mouseReleased);
-                    ofRemoveListener(events.mouseMoved, this, &view::mouseMoved);
-                    ofRemoveListener(events.mouseDragged, this, &view::mouseDragged);
-                    ofRemoveListener(events.windowResized, this, &view::windowResizedRoot);
+                // increased by every change which can affect result of collectHits, except moves and resizes of views.
+                // they are recorded in frameChangedViews instead, and can affect hits only in subtree bounds of them.
+                static inline std::uint64_t hitTestGeneration() { return hitTestGeneration_(); };
+                // views moved or resized after last clearFrameChanges, without destructed ones.
+                // if too many views are changed, they are dropped and hitTestGeneration is increased instead.
+                static inline const std::vector<view *> &frameChangedViews() { return frameChangedViews_(); };
+                static inline void clearFrameChanges() {
+                    for(auto &&v : frameChangedViews_()) v->isFrameChangeRecorded_ = false;
+                    frameChangedViews_().clear();
                 }
+                // increased when any view gets or loses subview
+                static inline std::uint64_t structureGeneration() { return structureGeneration_(); };
                 
                 void setForegroundColor(int r, int g, int b, int a = 255) {
                     ofSetColor(r, g, b, getAlpha() * a);
@@ -594,72 +975,377 @@ namespace bbb {
                 void setForegroundColor(int gray, int a = 255) {
                     ofSetColor(gray, gray, gray, getAlpha() * a);
                 }
-
+            
             protected:
+                struct dirty_flags {
+                    enum : std::uint8_t {
+                        none = 0,
+                        global_origin = 1 << 0,
+                        alpha = 1 << 1,
+                        all = global_origin | alpha
+                    };
+                };
+                
+                inline void cancelOwnAnimations() {
+                    auto &&manager = animation::manager::get();
+                    manager.cancelOwner(id_);
+                    manager.cancelTarget(this);
+                }
+                
+                // marks this view and its subviews. a dirty view always has dirty subviews,
+                // so we can stop at the first view already marked.
+                inline void invalidate(std::uint8_t flags) {
+                    flags &= ~dirtyFlags_;
+                    if(flags == dirty_flags::none) return;
+                    dirtyFlags_ |= flags;
+                    for(auto &&v : subviews) v->invalidate(flags);
+                }
+                
+                inline ofPoint localOrigin() const
+                { return position + ofPoint(setting_.margin.left, setting_.margin.top); };
+                
+                inline const ofPoint &globalOrigin() const {
+                    if(dirtyFlags_ & dirty_flags::global_origin) {
+                        auto &&p = parent.lock();
+                        globalOrigin_ = p ? (p->globalOrigin() + localOrigin()) : localOrigin();
+                        dirtyFlags_ &= ~dirty_flags::global_origin;
+                    }
+                    return globalOrigin_;
+                }
+                
                 setting setting_;
                 bool isClickedNow_{false};
-                std::shared_ptr<ofPoint> clickedPoint_;
+                ofPoint clickedPoint_;
                 
-                inline void mousePressed(ofMouseEventArgs &arg) {
-                    if(!isShown()) return;
-                    clickDown(ofPoint(arg.x, arg.y));
-                }
-                inline void mouseReleased(ofMouseEventArgs &arg) {
-                    if(!isShown()) return;
-                    clickUp(ofPoint(arg.x, arg.y));
+                bool isEventRoot_{false};
+                
+                friend struct event_router;
+                friend struct flat_tree;
+                
+                // called on destruction. (defined in event_router.hpp)
+                inline void forgetEvents();
+                
+                inline void dispatchMouse(const mouse_event_arg &arg) {
+                    mouseInternal(arg);
+                    if(arg.phase == event_phase::capture) {
+                        mouseCaptureCallback(arg);
+                        return;
+                    }
+                    switch(arg.type) {
+                        case mouse_event_type::down:
+                            if(!isClickedNow_) clickedPoint_ = arg.p;
+                            isClickedNow_ = true;
+                            clickDownCallback(arg);
+                            break;
+                        case mouse_event_type::up:
+                            clickUpCallback(arg);
+                            break;
+                        case mouse_event_type::over:
+                            mouseOverCallback(arg);
+                            break;
+                        case mouse_event_type::enter:
+                            mouseEnterCallback(arg);
+                            break;
+                        case mouse_event_type::leave:
+                            mouseLeaveCallback(arg);
+                            break;
+                        case mouse_event_type::drag:
+                            draggedCallback(arg);
+                            break;
+                    }
                 }
-                inline void mouseMoved(ofMouseEventArgs &arg) {
-                    if(!isShown()) return;
-                    mouseOver(ofPoint(arg.x, arg.y));
+                
+                inline void dispatchTouch(const touch_event_arg &arg) {
+                    touchInternal(arg);
+                    switch(arg.type) {
+                        case touch_event_type::down:
+                            touchDownCallback(arg);
+                            break;
+                        case touch_event_type::move:
+                            touchMovedCallback(arg);
+                            break;
+                        case touch_event_type::up:
+                            touchUpCallback(arg);
+                            break;
+                    }
                 }
-                inline void mouseDragged(ofMouseEventArgs &arg) {
-                    if(!isShown()) return;
-                    mouseOver(ofPoint(arg.x, arg.y));
+                
+                inline void releaseClick() {
+                    isClickedNow_ = false;
                 }
-                inline void windowResizedRoot(ofResizeEventArgs &arg) {
-                    windowResized({shared_from_this(), {ofPoint(), (float)arg.width, (float)arg.height}});
+                
+#pragma mark subviews management
+                
+                inline void insertSubview(std::vector<view::ref>::iterator it, const view::ref &v) {
+                    const std::size_t index = subviews.insert(it, v) - subviews.begin();
+                    for(std::size_t i = index; i < subviews.size(); ++i) subviews[i]->siblingIndex_ = i;
+                    ++structureGeneration_();
+                    hitTestChanged();
+                    boundsChanged();
+                    subviewLayoutChanged();
+                    if(v->hasDirtyLayout_) markLayoutPath();
+                    if(v->isNamed_) subviewsByName_.emplace(v->name, v.get());
+                    if(subviewIndex_) subviewIndex_->insert(v.get(), v->subtreeBoundsInParent(), isFrontOf);
                 }
                 
-                inline bool clickDown(const ofPoint &p) {
-                    if(!isShown()) return false;
-                    for(auto subview = subviews.rbegin();
-                        subview != subviews.rend();
-                        ++subview) if((*subview)->clickDown(p)) return true;
-                    if(isEnabledUserInteraction() && isInside(p)) {
-                        if(!isClickedNow_) clickedPoint_ = std::make_shared<ofPoint>(p);
-                        isClickedNow_ = true;
-                        clickDownCallback({shared_from_this(), p, false});
-                        return !isEventTransparent();
+                inline std::vector<view::ref>::iterator eraseSubview(std::vector<view::ref>::iterator it) {
+                    view *v = it->get();
+                    if(v->isNamed_) {
+                        auto &&range = subviewsByName_.equal_range(v->name);
+                        for(auto entry = range.first; entry != range.second; ++entry) {
+                            if(entry->second == v) {
+                                subviewsByName_.erase(entry);
+                                break;
+                            }
+                        }
                     }
-                    return false;
+                    if(subviewIndex_) {
+                        subviewIndex_->remove(v);
+                        if(v->isIndexEntryDirty_) {
+                            v->isIndexEntryDirty_ = false;
+                            pendingIndexUpdates_.erase(std::remove(pendingIndexUpdates_.begin(), pendingIndexUpdates_.end(), v),
+                                                       pendingIndexUpdates_.end());
+                        }
+                    }
+                    // removed view becomes a root, and its global origin no longer includes this
+                    v->parent.reset();
+                    v->invalidate(dirty_flags::global_origin);
+                    const std::size_t index = it - subviews.begin();
+                    it = subviews.erase(it);
+                    for(std::size_t i = index; i < subviews.size(); ++i) subviews[i]->siblingIndex_ = i;
+                    ++structureGeneration_();
+                    hitTestChanged();
+                    boundsChanged();
+                    subviewLayoutChanged();
+                    return it;
                 }
                 
-                inline bool clickUp(const ofPoint &p) {
-                    bool wasClicked = isClickedNow_;
-                    isClickedNow_ = false;
-                    clickedPoint_.reset();
+                inline void setName(const std::string &name) {
+                    this->name = name;
+                    isNamed_ = true;
+                }
+                
+                // if some subviews have same name, returns rearmost one as linear search did.
+                inline const view *findByName(const std::string &name) const {
+                    auto &&range = subviewsByName_.equal_range(name);
+                    const view *found = nullptr;
+                    for(auto it = range.first; it != range.second; ++it) {
+                        if(!found || it->second->siblingIndex_ < found->siblingIndex_) found = it->second;
+                    }
+                    if(found) return found;
                     
-                    if(!isShown()) return false;
-                    for(auto subview = subviews.rbegin();
-                        subview != subviews.rend();
-                        ++subview) if((*subview)->clickUp(p)) return true;
-                    if((isEnabledUserInteraction() && isInside(p)) || wasClicked) {
-                        clickUpCallback({shared_from_this(), p, false});
-                        return !isEventTransparent();
+                    // "view_<id>" of unnamed view isn't indexed
+                    std::uint64_t id;
+                    if(!parseDefaultName(name, id)) return nullptr;
+                    for(auto &&v : subviews) if(!v->isNamed_ && v->id_ == id) return v.get();
+                    return nullptr;
+                }
+                
+                static inline bool parseDefaultName(const std::string &name, std::uint64_t &id) {
+                    static const std::string prefix = "view_";
+                    if(name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix) != 0) return false;
+                    id = 0;
+                    for(auto it = name.begin() + prefix.size(); it != name.end(); ++it) {
+                        if(*it < '0' || '9' < *it) return false;
+                        id = id * 10 + (*it - '0');
                     }
-                    return false;
+                    return true;
                 }
                 
-                inline void mouseOver(const ofPoint &p) {
-                    if(!isShown()) return;
-                    for(auto subview = subviews.rbegin();
-                        subview != subviews.rend();
-                        ++subview) (*subview)->mouseOver(p);
-                    if((isEnabledUserInteraction() && isInside(p))) {
-                        mouseOverCallback({shared_from_this(), p, false});
+                static inline std::uint64_t issueId() {
+                    static std::uint64_t counter{0};
+                    return ++counter;
+                }
+                
+                inline bool isSubviewOf(const view &p) const
+                { return siblingIndex_ < p.subviews.size() && p.subviews[siblingIndex_].get() == this; };
+                
+                static inline bool isFrontOf(const view *lhs, const view *rhs)
+                { return rhs->siblingIndex_ < lhs->siblingIndex_; };
+                
+                // area used by isInside, in coordinate of given origin
+                inline ofRectangle hitRect(const ofPoint &origin = ofPoint()) const {
+                    auto &margin = setting_.margin;
+                    return ofRectangle(origin + ofPoint(margin.left, margin.top),
+                                       width - (margin.left + margin.right),
+                                       height + (margin.top - margin.bottom));
+                }
+                inline ofRectangle subtreeBoundsInParent() const {
+                    ofRectangle r = getSubtreeBounds();
+                    r.translate(localOrigin());
+                    return r;
+                }
+                
+                inline bool canHitSubviews(const ofPoint &p) const
+                { return !isClippingSubviews() || globalFrame().inside(p); };
+                
+                static inline bool &isArrangingLayout_() {
+                    static bool _{false};
+                    return _;
+                }
+                static inline bool isArrangingLayout() { return isArrangingLayout_(); };
+                
+                static inline std::vector<layout::item> &layoutItems() {
+                    static std::vector<layout::item> _;
+                    return _;
+                }
+                
+                inline bool isArrangedByParent() const {
+                    auto &&p = parent.lock();
+                    return p && p->layoutParams_.isStacking() && isShown();
+                }
+                
+                // marks this view and ancestors as having dirty layout in subtree.
+                // same as boundsChanged, a marked view always has marked ancestors.
+                inline void markLayoutPath() {
+                    if(hasDirtyLayout_) return;
+                    hasDirtyLayout_ = true;
+                    if(auto p = parent.lock()) p->markLayoutPath();
+                }
+                
+                // preferred size or params of this view was changed
+                inline void layoutChanged() {
+                    isMeasureDirty_ = true;
+                    isArrangeDirty_ = true;
+                    markLayoutPath();
+                    if(auto p = parent.lock()) p->subviewLayoutChanged();
+                }
+                
+                // subview was added, removed, or its preferred size was changed
+                inline void subviewLayoutChanged() {
+                    if(!layoutParams_.isStacking()) return;
+                    isArrangeDirty_ = true;
+                    markLayoutPath();
+                    if(layoutParams_.isFittingContent && !isMeasureDirty_) {
+                        isMeasureDirty_ = true;
+                        if(auto p = parent.lock()) p->subviewLayoutChanged();
+                    }
+                }
+                
+                // items of visible subviews. subviews are measured before collecting.
+                inline void collectLayoutItems() {
+                    const bool isHorizontal = layoutParams_.direction == layout::axis::horizontal;
+                    for(auto &&v : subviews) if(v->isShown()) v->measure();
+                    auto &&items = layoutItems();
+                    items.clear();
+                    for(auto &&v : subviews) {
+                        if(!v->isShown()) continue;
+                        auto &&params = v->layoutParams_;
+                        const ofPoint &size = v->measuredSize_;
+                        layout::item item;
+                        item.main = 0.0f <= params.basis ? params.basis : (isHorizontal ? size.x : size.y);
+                        item.cross = isHorizontal ? size.y : size.x;
+                        item.grow = params.grow;
+                        item.shrink = params.shrink;
+                        items.push_back(item);
+                    }
+                }
+                
+                inline void arrangeSubviews() {
+                    if(!layoutParams_.isStacking()) return;
+                    collectLayoutItems();
+                    auto &&items = layoutItems();
+                    layout::arrange(layoutParams_, width, height, items);
+                    std::size_t i = 0;
+                    for(auto &&v : subviews) {
+                        if(!v->isShown()) continue;
+                        auto &&item = items[i++];
+                        v->setFrameByLayout(item.x, item.y, item.width, item.height);
                     }
                 }
                 
+                // doesn't change preferred size
+                inline void setFrameByLayout(float x, float y, float w, float h) {
+                    if(position.x != x || position.y != y) setOrigin(x, y);
+                    if(setting_.frame.width == w && setting_.frame.height == h) return;
+                    isArrangingLayout_() = true;
+                    setSize(w, h);
+                    isArrangingLayout_() = false;
+                }
+                
+                static inline std::uint64_t &hitTestGeneration_() {
+                    static std::uint64_t _{0};
+                    return _;
+                }
+                static inline void hitTestChanged() { ++hitTestGeneration_(); };
+                
+                static constexpr std::size_t maxFrameChanges = 64;
+                static inline std::vector<view *> &frameChangedViews_() {
+                    static std::vector<view *> _;
+                    return _;
+                }
+                inline void recordFrameChange() {
+                    if(isFrameChangeRecorded_) return;
+                    auto &&views = frameChangedViews_();
+                    if(views.size() == maxFrameChanges) {
+                        hitTestChanged();
+                        clearFrameChanges();
+                    }
+                    isFrameChangeRecorded_ = true;
+                    views.push_back(this);
+                }
+                inline void forgetFrameChange() {
+                    if(!isFrameChangeRecorded_) return;
+                    auto &&views = frameChangedViews_();
+                    views.erase(std::remove(views.begin(), views.end(), this), views.end());
+                }
+                
+                static inline std::uint64_t &structureGeneration_() {
+                    static std::uint64_t _{0};
+                    return _;
+                }
+                
+                // shrinks r to a rect which contains p and doesn't overlap area.
+                // if there is no such rect, p is left out of r.
+                static inline void excludeArea(ofRectangle &r, const ofRectangle &area, const ofPoint &p) {
+                    if(!r.intersects(area)) return;
+                    ofRectangle best(p.x, p.y, 0.0f, 0.0f);
+                    auto &&consider = [&](float x0, float y0, float x1, float y1) {
+                        if(x1 <= x0 || y1 <= y0) return;
+                        const ofRectangle c(x0, y0, x1 - x0, y1 - y0);
+                        if(c.inside(p) && best.getArea() < c.getArea()) best = c;
+                    };
+                    consider(r.getMinX(), r.getMinY(), area.getMinX(), r.getMaxY());
+                    consider(area.getMaxX(), r.getMinY(), r.getMaxX(), r.getMaxY());
+                    consider(r.getMinX(), r.getMinY(), r.getMaxX(), area.getMinY());
+                    consider(r.getMinX(), area.getMaxY(), r.getMaxX(), r.getMaxY());
+                    r = best;
+                }
+                
+                // marks subtree bounds of this view and ancestors. a dirty view always has dirty ancestors.
+                // entries of them on indices of their parents are refreshed at next query.
+                inline void boundsChanged() {
+                    if(isBoundsDirty_) return;
+                    isBoundsDirty_ = true;
+                    auto &&p = parent.lock();
+                    if(!p) return;
+                    indexEntryChanged(*p);
+                    p->boundsChanged();
+                }
+                
+                // position or size was changed. bounds in local coordinate may be same, but entry on parent's index isn't.
+                inline void frameChanged() {
+                    recordFrameChange();
+                    boundsChanged();
+                    if(auto p = parent.lock()) indexEntryChanged(*p);
+                }
+                
+                inline void indexEntryChanged(view &p) {
+                    if(isIndexEntryDirty_ || !p.subviewIndex_ || !isSubviewOf(p)) return;
+                    isIndexEntryDirty_ = true;
+                    p.pendingIndexUpdates_.push_back(this);
+                }
+                
+                // subviews possibly containing p, front to back
+                inline const std::vector<view *> &querySubviews(const ofPoint &p) {
+                    for(auto &&v : pendingIndexUpdates_) {
+                        v->isIndexEntryDirty_ = false;
+                        subviewIndex_->update(v, v->subtreeBoundsInParent(), isFrontOf);
+                    }
+                    pendingIndexUpdates_.clear();
+                    return subviewIndex_->query(convertToLocalCoordinate(p));
+                }
+                
                 inline void pushState() const {
                     ofPushMatrix();
                     ofPushStyle();
@@ -671,18 +1357,92 @@ namespace bbb {
                 }
                 
                 inline void drawBackground() const {
-                    if(0.0f < getBackgroundColor().a * getAlpha()) {
-                        auto &&c = ofFloatColor(getBackgroundColor().r,
-                                                getBackgroundColor().g,
-                                                getBackgroundColor().b,
-                                                getBackgroundColor().a * getAlpha());
-                        ofSetColor(c);
+                    auto &&bg = getBackgroundColor();
+                    const float a = bg.a * getAlpha();
+                    if(0.0f < a) {
+                        ofSetColor(ofFloatColor(bg.r, bg.g, bg.b, a));
                         ofDrawRectangle(0.0f, 0.0f, width, height);
                     }
                 }
                 
-                inline void drawSubviews() const {
-                    for(auto &&v : subviews) v->draw();
+                // plain view draws nothing other than background, so it doesn't break batch
+                virtual bool isBatchable() const { return typeid(*this) == typeid(view); };
+                
+                // same walk as drawTree. if isClipped, visibleRect is the area clipped by ancestors.
+                inline void appendToBatch(background_batch &batch, const ofRectangle &visibleRect, bool isClipped, bool drawsCustom) {
+                    if(!isShown() || getAlpha() <= 0.0f) return;
+                    if(!visibleRect.intersects(getGlobalSubtreeBounds())) {
+                        if(drawsCustom) cullingStats().culled += subtreeSize_;
+                        return;
+                    }
+                    if(drawsCustom) ++cullingStats().drawn;
+                    auto &&bg = getBackgroundColor();
+                    const float a = bg.a * getAlpha();
+                    if(0.0f < a) {
+                        // quad is cut instead of scissor, so batch isn't broken
+                        const ofRectangle quad = isClipped ? visibleRect.getIntersection(globalFrame()) : globalFrame();
+                        if(0.0f < quad.width && 0.0f < quad.height) batch.addQuad(quad, ofFloatColor(bg.r, bg.g, bg.b, a));
+                    }
+                    if(drawsCustom && !isBatchable()) {
+                        batch.flush();
+                        pushState();
+                        ofTranslate(globalOrigin());
+                        if(isClipped) {
+                            scoped_scissor scissor(visibleRect);
+                            drawInternal();
+                        } else {
+                            drawInternal();
+                        }
+                        popState();
+                    }
+                    if(isClippingSubviews()) {
+                        const ofRectangle clipped = visibleRect.getIntersection(globalFrame());
+                        for(auto &&v : subviews) v->appendToBatch(batch, clipped, true, drawsCustom);
+                    } else {
+                        for(auto &&v : subviews) v->appendToBatch(batch, visibleRect, isClipped, drawsCustom);
+                    }
+                }
+                
+                static inline culling_stats &cullingStats() {
+                    static culling_stats stats;
+                    return stats;
+                }
+                static inline void beginCullingFrame() {
+                    auto &&stats = cullingStats();
+                    if(stats.frame != ofGetFrameNum()) {
+                        stats.drawn = stats.culled = 0;
+                        stats.frame = ofGetFrameNum();
+                    }
+                }
+                
+                inline ofRectangle globalFrame() const { return ofRectangle(globalOrigin(), width, height); };
+                
+                // draws this view and subviews. subviews are drawn through this, so overriding it changes
+                // drawing of the view wherever it is in the tree.
+                virtual void drawTree(const ofRectangle &visibleRect) {
+                    // faded out subtree draws nothing, so skip it entirely
+                    if(!isShown() || getAlpha() <= 0.0f) return;
+                    if(!visibleRect.intersects(getGlobalSubtreeBounds())) {
+                        cullingStats().culled += subtreeSize_;
+                        return;
+                    }
+                    ++cullingStats().drawn;
+                    pushState();
+                    ofTranslate(localOrigin());
+                    drawBackground();
+                    drawInternal();
+                    if(isClippingSubviews()) {
+                        const ofRectangle clipped = visibleRect.getIntersection(globalFrame());
+                        scoped_scissor scissor(clipped);
+                        drawSubviews(clipped);
+                    } else {
+                        drawSubviews(visibleRect);
+                    }
+                    popState();
+                }
+                
+                inline void drawSubviews(const ofRectangle &visibleRect) const {
+                    for(auto &&v : subviews) v->drawTree(visibleRect);
                 }
                 
                 virtual void drawInternal() {};
@@ -690,7 +1450,7 @@ namespace bbb {
                 inline void windowResized(resized_event_arg super_arg) {
                     windowResizeInternal(super_arg);
                     for(auto &&subview : subviews) {
-                        subview->windowResized({subview, {position, width, height}});
+                        subview->windowResized({subview.get(), {position, width, height}});
                     }
                 }
                 
@@ -698,32 +1458,97 @@ namespace bbb {
                     windowResizedCallback(arg);
                 };
                 
+                // called before callbacks, for subclasses handling events by themselves.
+                // user callbacks of them stay available.
+                virtual void mouseInternal(const mouse_event_arg &) {};
+                virtual void touchInternal(const touch_event_arg &) {};
+                
                 ofPoint position;
                 float width;
                 float height;
                 
+                mutable ofPoint globalOrigin_;
+                mutable ofRectangle subtreeBounds_;
+                mutable std::size_t subtreeSize_{1};
+                mutable bool isBoundsDirty_{true};
+                mutable float effectiveAlpha_{1.0f};
+                mutable std::uint8_t dirtyFlags_{dirty_flags::all};
+                
                 bbb::opt_arg_function<void(mouse_event_arg)> clickDownCallback{mouse_default};
                 bbb::opt_arg_function<void(mouse_event_arg)> clickUpCallback{mouse_default};
                 bbb::opt_arg_function<void(mouse_event_arg)> mouseOverCallback{mouse_default};
+                bbb::opt_arg_function<void(mouse_event_arg)> mouseEnterCallback{mouse_default};
+                bbb::opt_arg_function<void(mouse_event_arg)> mouseLeaveCallback{mouse_default};
                 bbb::opt_arg_function<void(mouse_event_arg)> draggedCallback{mouse_default};
+                bbb::opt_arg_function<void(mouse_event_arg)> mouseCaptureCallback{mouse_default};
+                
+                bbb::opt_arg_function<void(touch_event_arg)> touchDownCallback{touch_default};
+                bbb::opt_arg_function<void(touch_event_arg)> touchMovedCallback{touch_default};
+                bbb::opt_arg_function<void(touch_event_arg)> touchUpCallback{touch_default};
+                std::size_t numTouches_{0};
+                
+                layout::params layoutParams_;
+                ofPoint preferredSize_;
+                ofPoint measuredSize_;
+                bool isMeasureDirty_{true};
+                bool isArrangeDirty_{true};
+                bool hasDirtyLayout_{true};
                 
                 bbb::opt_arg_function<void(resized_event_arg)> windowResizedCallback{resized_default};
                 
-                std::string name{""};
+                const std::uint64_t id_{issueId()};
+                mutable std::string name{""};
+                bool isNamed_{false};
                 std::vector<view::ref> subviews;
                 std::weak_ptr<view> parent{};
+                
+                std::size_t siblingIndex_{0};
+                std::unordered_multimap<std::string, view *> subviewsByName_;
+                std::unique_ptr<uniform_grid<view>> subviewIndex_;
+                std::vector<view *> pendingIndexUpdates_;
+                bool isIndexEntryDirty_{false};
+                bool isFrameChangeRecorded_{false};
             };
             
             namespace { // make static
                 void mouse_default(mouse_event_arg) {};
+                void touch_default(touch_event_arg) {};
                 void resized_default(resized_event_arg arg) {};
                 void fitToParent(resized_event_arg arg) {
                     arg.target->setSize(arg.rect.width, arg.rect.height);
                 };
             };
+            
+            inline view_ref event_arg::ref() const { return target ? target->shared_from_this() : view_ref(); };
         }; // components
+        
+        namespace tween {
+            namespace property {
+                inline std::string position::label(const view &v) { return v.getName() + "::move_animation"; };
+                inline position::value_type position::get(const view &v) { return v.getPosition(); };
+                inline void position::set(view &v, const value_type &value) { v.setPosition(value); };
+                
+                inline std::string size::label(const view &v) { return v.getName() + "::resize_animation"; };
+                inline size::value_type size::get(const view &v) { return {v.getFrame().width, v.getFrame().height}; };
+                inline void size::set(view &v, const value_type &value) { v.setSize(value.x, value.y); };
+                
+                inline std::string alpha::label(const view &v) { return v.getName() + "::fade_animation"; };
+                inline alpha::value_type alpha::get(const view &v) { return v.getSetting().alpha; };
+                inline void alpha::set(view &v, const value_type &value) { v.setAlpha(value); };
+                
+                inline std::string background_color::label(const view &v) { return v.getName() + "::background_color_animation"; };
+                inline background_color::value_type background_color::get(const view &v) { return v.getBackgroundColor(); };
+                inline void background_color::set(view &v, const value_type &value) { v.setBackgroundColor(value); };
+                
+                inline std::string margin::label(const view &v) { return v.getName() + "::margin_animation"; };
+                inline margin::value_type margin::get(const view &v) { return v.getSetting().margin; };
+                inline void margin::set(view &v, const value_type &value) { v.setMargin(value.top, value.right, value.bottom, value.left); };
+            };
+        };
     }; // view_system
     namespace vs = view_system;
 }; // bbb
 
+#include "./event_router.hpp"
+
 #endif /* bbb_components_view_hpp */
@@ -8,14 +8,216 @@
 #define easing_hpp
 
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 
 #ifndef _USE_MATH_DEFINES
 #   define _USE_MATH_DEFINES
 #endif
 #include <math.h>
 
+// array versions of easing use SIMD if available. define BBB_EASING_NO_SIMD to disable.
+#if !defined(BBB_EASING_NO_SIMD)
+#   if defined(__AVX__)
+#       include <immintrin.h>
+#       define BBB_EASING_AVX
+#   elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && 1 <= _M_IX86_FP)
+#       include <xmmintrin.h>
+#       define BBB_EASING_SSE
+#   elif defined(__ARM_NEON) && defined(__aarch64__)
+#       include <arm_neon.h>
+#       define BBB_EASING_NEON
+#   endif
+#endif
+
 namespace bbb {
     namespace easing {
+        namespace detail {
+#if defined(BBB_EASING_AVX)
+            struct vfloat {
+                enum : std::size_t { width = 8 };
+                __m256 v;
+                vfloat() = default;
+                vfloat(__m256 v) : v(v) {};
+                vfloat(float f) : v(_mm256_set1_ps(f)) {};
+                static inline vfloat load(const float *p) { return _mm256_loadu_ps(p); };
+                inline void store(float *p) const { _mm256_storeu_ps(p, v); };
+                friend inline vfloat operator+(vfloat a, vfloat b) { return _mm256_add_ps(a.v, b.v); };
+                friend inline vfloat operator-(vfloat a, vfloat b) { return _mm256_sub_ps(a.v, b.v); };
+                friend inline vfloat operator*(vfloat a, vfloat b) { return _mm256_mul_ps(a.v, b.v); };
+                friend inline vfloat less(vfloat a, vfloat b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ); };
+                friend inline vfloat select(vfloat mask, vfloat a, vfloat b) { return _mm256_blendv_ps(b.v, a.v, mask.v); };
+                friend inline vfloat sqrt(vfloat a) { return _mm256_sqrt_ps(a.v); };
+            };
+#elif defined(BBB_EASING_SSE)
+            struct vfloat {
+                enum : std::size_t { width = 4 };
+                __m128 v;
+                vfloat() = default;
+                vfloat(__m128 v) : v(v) {};
+                vfloat(float f) : v(_mm_set1_ps(f)) {};
+                static inline vfloat load(const float *p) { return _mm_loadu_ps(p); };
+                inline void store(float *p) const { _mm_storeu_ps(p, v); };
+                friend inline vfloat operator+(vfloat a, vfloat b) { return _mm_add_ps(a.v, b.v); };
+                friend inline vfloat operator-(vfloat a, vfloat b) { return _mm_sub_ps(a.v, b.v); };
+                friend inline vfloat operator*(vfloat a, vfloat b) { return _mm_mul_ps(a.v, b.v); };
+                friend inline vfloat less(vfloat a, vfloat b) { return _mm_cmplt_ps(a.v, b.v); };
+                friend inline vfloat select(vfloat mask, vfloat a, vfloat b)
+                { return _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)); };
+                friend inline vfloat sqrt(vfloat a) { return _mm_sqrt_ps(a.v); };
+            };
+#elif defined(BBB_EASING_NEON)
+            struct vfloat {
+                enum : std::size_t { width = 4 };
+                float32x4_t v;
+                vfloat() = default;
+                vfloat(float32x4_t v) : v(v) {};
+                vfloat(float f) : v(vdupq_n_f32(f)) {};
+                static inline vfloat load(const float *p) { return vld1q_f32(p); };
+                inline void store(float *p) const { vst1q_f32(p, v); };
+                friend inline vfloat operator+(vfloat a, vfloat b) { return vaddq_f32(a.v, b.v); };
+                friend inline vfloat operator-(vfloat a, vfloat b) { return vsubq_f32(a.v, b.v); };
+                friend inline vfloat operator*(vfloat a, vfloat b) { return vmulq_f32(a.v, b.v); };
+                friend inline vfloat less(vfloat a, vfloat b) { return vreinterpretq_f32_u32(vcltq_f32(a.v, b.v)); };
+                friend inline vfloat select(vfloat mask, vfloat a, vfloat b)
+                { return vbslq_f32(vreinterpretq_u32_f32(mask.v), a.v, b.v); };
+                friend inline vfloat sqrt(vfloat a) { return vsqrtq_f32(a.v); };
+            };
+#endif
+            
+            // applies curve::apply to blocks of vfloat::width, and scalar to remainder.
+            // without SIMD, all values are evaluated by scalar.
+            template <typename curve>
+            inline void transform(const float *in, float *out, std::size_t n, float (*scalar)(float)) {
+                std::size_t i = 0;
+#if defined(BBB_EASING_AVX) || defined(BBB_EASING_SSE) || defined(BBB_EASING_NEON)
+                for(; i + vfloat::width <= n; i += vfloat::width) {
+                    curve::apply(vfloat::load(in + i)).store(out + i);
+                }
+#endif
+                for(; i < n; ++i) out[i] = scalar(in[i]);
+            }
+            
+            inline void transform(const float *in, float *out, std::size_t n, float (*scalar)(float)) {
+                for(std::size_t i = 0; i < n; ++i) out[i] = scalar(in[i]);
+            }
+            
+            // branchless versions of curves. both branches are evaluated and selected.
+            namespace curves {
+                struct quadratic_in {
+                    template <typename v> static inline v apply(v t) { return t * t; };
+                };
+                struct quadratic_out {
+                    template <typename v> static inline v apply(v t) { return t * (v(2.0f) - t); };
+                };
+                struct quadratic_in_out {
+                    template <typename v> static inline v apply(v t) {
+                        t = t * v(2.0f);
+                        const v u = t - v(1.0f);
+                        return select(less(t, v(1.0f)),
+                                      v(0.5f) * t * t,
+                                      v(0.5f) * (v(1.0f) + u * (v(2.0f) - u)));
+                    };
+                };
+                
+                struct cubic_in {
+                    template <typename v> static inline v apply(v t) { return t * t * t; };
+                };
+                struct cubic_out {
+                    template <typename v> static inline v apply(v t) {
+                        t = t - v(1.0f);
+                        return t * t * t + v(1.0f);
+                    };
+                };
+                struct cubic_in_out {
+                    template <typename v> static inline v apply(v t) {
+                        t = t * v(2.0f);
+                        const v u = t - v(2.0f);
+                        return select(less(t, v(1.0f)),
+                                      v(0.5f) * t * t * t,
+                                      v(0.5f) * (u * u * u + v(2.0f)));
+                    };
+                };
+                
+                struct quartic_in {
+                    template <typename v> static inline v apply(v t) {
+                        t = t * t;
+                        return t * t;
+                    };
+                };
+                struct quartic_out {
+                    template <typename v> static inline v apply(v t) {
+                        t = t - v(1.0f);
+                        t = t * t;
+                        return v(1.0f) - t * t;
+                    };
+                };
+                struct quartic_in_out {
+                    template <typename v> static inline v apply(v t) {
+                        t = t * v(2.0f);
+                        const v t2 = t * t;
+                        v u = t - v(2.0f);
+                        u = u * u;
+                        return select(less(t, v(1.0f)),
+                                      v(0.5f) * t2 * t2,
+                                      v(1.0f) - v(0.5f) * u * u);
+                    };
+                };
+                
+                struct quintic_in {
+                    template <typename v> static inline v apply(v t) {
+                        const v t2 = t * t;
+                        return t2 * t2 * t;
+                    };
+                };
+                struct quintic_out {
+                    template <typename v> static inline v apply(v t) {
+                        t = t - v(1.0f);
+                        const v t2 = t * t;
+                        return t2 * t2 * t + v(1.0f);
+                    };
+                };
+                struct quintic_in_out {
+                    template <typename v> static inline v apply(v t) {
+                        t = t * v(2.0f);
+                        const v t2 = t * t;
+                        const v u = t - v(2.0f);
+                        const v u2 = u * u;
+                        return select(less(t, v(1.0f)),
+                                      v(0.5f) * t2 * t2 * t,
+                                      v(0.5f) * u2 * u2 * u + v(1.0f));
+                    };
+                };
+                
+                struct circular_in {
+                    template <typename v> static inline v apply(v t) { return v(1.0f) - sqrt(v(1.0f) - t * t); };
+                };
+                struct circular_out {
+                    template <typename v> static inline v apply(v t) {
+                        t = t - v(1.0f);
+                        return sqrt(v(1.0f) - t * t);
+                    };
+                };
+                struct circular_in_out {
+                    template <typename v> static inline v apply(v t) {
+                        t = t * v(2.0f);
+                        const v u = t - v(2.0f);
+                        // sqrt of not selected branch can be NaN, but it is discarded by select
+                        return select(less(t, v(1.0f)),
+                                      v(-0.5f) * (sqrt(v(1.0f) - t * t) - v(1.0f)),
+                                      v(0.5f) * (sqrt(v(1.0f) - u * u) + v(1.0f)));
+                    };
+                };
+            };
+        };
+        
+        static inline float linear(float t) {
+            return t;
+        }
+        static inline void linear(const float *t, float *result, std::size_t n) {
+            for(std::size_t i = 0; i < n; ++i) result[i] = t[i];
+        }
+        
         namespace quadratic {
             static inline float in(float t) {
                 return t * t;
@@ -29,6 +231,14 @@ namespace bbb {
                 t -= 1.0f;
                 return 0.5 * (1.0f + t * (2.0f - t));
             }
+            
+            // array versions
+            static inline void in(const float *t, float *result, std::size_t n)
+            { detail::transform<detail::curves::quadratic_in>(t, result, n, in); };
+            static inline void out(const float *t, float *result, std::size_t n)
+            { detail::transform<detail::curves::quadratic_out>(t, result, n, out); };
+            static inline void in_out(const float *t, float *result, std::size_t n)
+            { detail::transform<detail::curves::quadratic_in_out>(t, result, n, in_out); };
         };
         namespace quad = quadratic;
         
@@ -46,6 +256,14 @@ namespace bbb {
                 t -= 2.0f;
                 return 0.5f * (t * t * t + 2.0f);
             }
+            
+            // array versions
+            static inline void in(const float *t, float *result, std::size_t n)
+            { detail::transform<detail::curves::cubic_in>(t, result, n, in); };
+            static inline void out(const float *t, float *result, std::size_t n)
+            { detail::transform<detail::curves::cubic_out>(t, result, n, out); };
+            static inline void in_out(const float *t, float *result, std::size_t n)
+            { detail::transform<detail::curves::cubic_in_out>(t, result, n, in_out); };
         };
         
         namespace quartic {
@@ -62,6 +280,14 @@ namespace bbb {
                 t -= 2.0f;
                 return 1 - 0.5f * t * t * t * t;
             }
+            
+            // array versions
+            static inline void in(const float *t, float *result, std::size_t n)
+            { detail::transform<detail::curves::quartic_in>(t, result, n, in); };
+            static inline void out(const float *t, float *result, std::size_t n)
+            { detail::transform<detail::curves::quartic_out>(t, result, n, out); };
+            static inline void in_out(const float *t, float *result, std::size_t n)
+            { detail::transform<detail::curves::quartic_in_out>(t, result, n, in_out); };
         };
         namespace quart = quartic;
         
@@ -73,12 +299,20 @@ namespace bbb {
                 t -= 1.0f;
                 return t * t * t * t * t + 1.0f;
             }
-            static inline float in_out(float t,float totaltime,float max ,float min) {
+            static inline float in_out(float t) {
                 t *= 2.0f;
                 if(t < 1.0f) return 0.5f * t * t * t * t * t;
                 t -= 2.0f;
                 return 0.5f * t * t * t * t * t + 1.0f;
             }
+            
+            // array versions
+            static inline void in(const float *t, float *result, std::size_t n)
+            { detail::transform<detail::curves::quintic_in>(t, result, n, in); };
+            static inline void out(const float *t, float *result, std::size_t n)
+            { detail::transform<detail::curves::quintic_out>(t, result, n, out); };
+            static inline void in_out(const float *t, float *result, std::size_t n)
+            { detail::transform<detail::curves::quintic_in_out>(t, result, n, in_out); };
         };
         namespace quin = quintic;
         
@@ -92,6 +326,14 @@ namespace bbb {
             static inline float in_out(float t) {
                 return 0.5f - 0.5f * std::cos(t * M_PI);
             }
+            
+            // array versions. these are evaluated by scalar.
+            static inline void in(const float *t, float *result, std::size_t n)
+            { detail::transform(t, result, n, in); };
+            static inline void out(const float *t, float *result, std::size_t n)
+            { detail::transform(t, result, n, out); };
+            static inline void in_out(const float *t, float *result, std::size_t n)
+            { detail::transform(t, result, n, in_out); };
         };
         namespace sin = sine;
         
@@ -109,6 +351,14 @@ namespace bbb {
                 t -= 1.0f;
                 return 1.0f - 0.5f * std::pow(2.0f, -10.0f * t);
             }
+            
+            // array versions. these are evaluated by scalar.
+            static inline void in(const float *t, float *result, std::size_t n)
+            { detail::transform(t, result, n, in); };
+            static inline void out(const float *t, float *result, std::size_t n)
+            { detail::transform(t, result, n, out); };
+            static inline void in_out(const float *t, float *result, std::size_t n)
+            { detail::transform(t, result, n, in_out); };
         };
         namespace exp = exponential;
         
@@ -121,13 +371,89 @@ namespace bbb {
                 return std::sqrt(1.0f - t * t);
             }
             static inline float in_out(float t) {
-                t *= 0.5f;
+                t *= 2.0f;
                 if(t < 1.0f) return -0.5f * (std::sqrt(1.0f - t * t) - 1.0f);
                 t -= 2.0f;
                 return 0.5f * (std::sqrt(1.0f - t * t) + 1.0f);
             }
+            
+            // array versions
+            static inline void in(const float *t, float *result, std::size_t n)
+            { detail::transform<detail::curves::circular_in>(t, result, n, in); };
+            static inline void out(const float *t, float *result, std::size_t n)
+            { detail::transform<detail::curves::circular_out>(t, result, n, out); };
+            static inline void in_out(const float *t, float *result, std::size_t n)
+            { detail::transform<detail::curves::circular_in_out>(t, result, n, in_out); };
         };
         namespace circ = circular;
+        
+        // identifies easing function as plain data, e.g. for typed tweens
+        enum class type : std::uint8_t {
+            linear,
+            quadratic_in, quadratic_out, quadratic_in_out,
+            cubic_in, cubic_out, cubic_in_out,
+            quartic_in, quartic_out, quartic_in_out,
+            quintic_in, quintic_out, quintic_in_out,
+            sine_in, sine_out, sine_in_out,
+            exponential_in, exponential_out, exponential_in_out,
+            circular_in, circular_out, circular_in_out
+        };
+        
+        static inline float evaluate(type e, float t) {
+            switch(e) {
+                case type::linear:             return linear(t);
+                case type::quadratic_in:       return quadratic::in(t);
+                case type::quadratic_out:      return quadratic::out(t);
+                case type::quadratic_in_out:   return quadratic::in_out(t);
+                case type::cubic_in:           return cubic::in(t);
+                case type::cubic_out:          return cubic::out(t);
+                case type::cubic_in_out:       return cubic::in_out(t);
+                case type::quartic_in:         return quartic::in(t);
+                case type::quartic_out:        return quartic::out(t);
+                case type::quartic_in_out:     return quartic::in_out(t);
+                case type::quintic_in:         return quintic::in(t);
+                case type::quintic_out:        return quintic::out(t);
+                case type::quintic_in_out:     return quintic::in_out(t);
+                case type::sine_in:            return sine::in(t);
+                case type::sine_out:           return sine::out(t);
+                case type::sine_in_out:        return sine::in_out(t);
+                case type::exponential_in:     return exponential::in(t);
+                case type::exponential_out:    return exponential::out(t);
+                case type::exponential_in_out: return exponential::in_out(t);
+                case type::circular_in:        return circular::in(t);
+                case type::circular_out:       return circular::out(t);
+                case type::circular_in_out:    return circular::in_out(t);
+            }
+            return t;
+        }
+        
+        static inline void evaluate(type e, const float *t, float *result, std::size_t n) {
+            switch(e) {
+                case type::linear:             linear(t, result, n); return;
+                case type::quadratic_in:       quadratic::in(t, result, n); return;
+                case type::quadratic_out:      quadratic::out(t, result, n); return;
+                case type::quadratic_in_out:   quadratic::in_out(t, result, n); return;
+                case type::cubic_in:           cubic::in(t, result, n); return;
+                case type::cubic_out:          cubic::out(t, result, n); return;
+                case type::cubic_in_out:       cubic::in_out(t, result, n); return;
+                case type::quartic_in:         quartic::in(t, result, n); return;
+                case type::quartic_out:        quartic::out(t, result, n); return;
+                case type::quartic_in_out:     quartic::in_out(t, result, n); return;
+                case type::quintic_in:         quintic::in(t, result, n); return;
+                case type::quintic_out:        quintic::out(t, result, n); return;
+                case type::quintic_in_out:     quintic::in_out(t, result, n); return;
+                case type::sine_in:            sine::in(t, result, n); return;
+                case type::sine_out:           sine::out(t, result, n); return;
+                case type::sine_in_out:        sine::in_out(t, result, n); return;
+                case type::exponential_in:     exponential::in(t, result, n); return;
+                case type::exponential_out:    exponential::out(t, result, n); return;
+                case type::exponential_in_out: exponential::in_out(t, result, n); return;
+                case type::circular_in:        circular::in(t, result, n); return;
+                case type::circular_out:       circular::out(t, result, n); return;
+                case type::circular_in_out:    circular::in_out(t, result, n); return;
+            }
+            linear(t, result, n);
+        }
     };
 };
 
@@ -0,0 +1,139 @@
+//
+//  easing_table.hpp
+//
+//  Created by ISHII 2bit on 2018/03/22.
+//
+
+#pragma once
+
+#ifndef bbb_easing_table_hpp
+#define bbb_easing_table_hpp
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include <memory>
+#include <utility>
+
+#include "easing.hpp"
+
+namespace bbb {
+    namespace easing {
+        // css style cubic-bezier(x1, y1, x2, y2). x1 and x2 are clamped to [0, 1].
+        // x is solved by Newton's method, and by bisection if it doesn't converge.
+        struct cubic_bezier {
+            cubic_bezier(float x1, float y1, float x2, float y2) {
+                x1 = x1 < 0.0f ? 0.0f : (1.0f < x1 ? 1.0f : x1);
+                x2 = x2 < 0.0f ? 0.0f : (1.0f < x2 ? 1.0f : x2);
+                cx = 3.0f * x1;
+                bx = 3.0f * (x2 - x1) - cx;
+                ax = 1.0f - cx - bx;
+                cy = 3.0f * y1;
+                by = 3.0f * (y2 - y1) - cy;
+                ay = 1.0f - cy - by;
+            };
+            
+            inline float operator()(float x) const {
+                if(x <= 0.0f) return 0.0f;
+                if(1.0f <= x) return 1.0f;
+                return sampleY(solve(x));
+            };
+            
+        private:
+            inline float sampleX(float s) const { return ((ax * s + bx) * s + cx) * s; };
+            inline float sampleY(float s) const { return ((ay * s + by) * s + cy) * s; };
+            inline float sampleDerivativeX(float s) const { return (3.0f * ax * s + 2.0f * bx) * s + cx; };
+            
+            // returns parameter s where sampleX(s) == x
+            inline float solve(float x) const {
+                const float epsilon = 1.0e-6f;
+                float s = x;
+                for(int i = 0; i < 8; ++i) {
+                    const float dx = sampleX(s) - x;
+                    if(std::fabs(dx) < epsilon) return s;
+                    const float d = sampleDerivativeX(s);
+                    if(std::fabs(d) < 1.0e-6f) break;
+                    s -= dx / d;
+                }
+                
+                float lower = 0.0f, upper = 1.0f;
+                s = x;
+                for(int i = 0; i < 32; ++i) {
+                    const float v = sampleX(s);
+                    if(std::fabs(v - x) < epsilon) break;
+                    if(v < x) lower = s;
+                    else upper = s;
+                    s = 0.5f * (lower + upper);
+                }
+                return s;
+            };
+            
+            float ax, bx, cx;
+            float ay, by, cy;
+        };
+        
+        // samples easing function in [0, 1] at construction, and evaluates it by linear interpolation.
+        // error of 256 samples is about 1e-3 for exponential, but about 2e-2 for circular because of its vertical ends.
+        struct table {
+            template <typename function_t, typename = decltype(std::declval<function_t>()(0.0f))>
+            explicit table(function_t f, std::size_t resolution = 256)
+            : samples(resolution < 2 ? 2 : resolution)
+            , scale(static_cast<float>(samples.size() - 1))
+            {
+                for(std::size_t i = 0; i < samples.size(); ++i) samples[i] = f(i / scale);
+            };
+            explicit table(type e, std::size_t resolution = 256)
+            : table([e](float t) { return evaluate(e, t); }, resolution) {};
+            
+            inline float operator()(float t) const {
+                if(!(0.0f < t)) return samples.front();
+                const float x = t * scale;
+                const std::size_t i = static_cast<std::size_t>(x);
+                if(samples.size() - 1 <= i) return samples.back();
+                return samples[i] + (samples[i + 1] - samples[i]) * (x - i);
+            };
+            inline void operator()(const float *t, float *result, std::size_t n) const {
+                for(std::size_t i = 0; i < n; ++i) result[i] = operator()(t[i]);
+            };
+            
+            inline std::size_t getResolution() const { return samples.size(); };
+            
+            // shared table of builtin easing, built at first use
+            static inline const table &of(type e) {
+                static std::unique_ptr<table> tables[static_cast<std::size_t>(type::circular_in_out) + 1];
+                auto &&t = tables[static_cast<std::size_t>(e)];
+                if(!t) t.reset(new table(e));
+                return *t;
+            };
+            
+        private:
+            std::vector<float> samples;
+            float scale;
+        };
+        
+        // easing given as builtin type or table.
+        // table is referred, so it has to outlive this.
+        struct curve {
+            curve(type e = type::linear)
+            : e(e), lut(nullptr) {};
+            curve(const table &lut)
+            : e(type::linear), lut(&lut) {};
+            
+            inline float operator()(float t) const
+            { return lut ? (*lut)(t) : evaluate(e, t); };
+            inline void operator()(const float *t, float *result, std::size_t n) const {
+                if(lut) (*lut)(t, result, n);
+                else evaluate(e, t, result, n);
+            };
+            
+            inline bool operator==(const curve &rhs) const { return e == rhs.e && lut == rhs.lut; };
+            inline bool operator!=(const curve &rhs) const { return !operator==(rhs); };
+            
+        private:
+            type e;
+            const table *lut;
+        };
+    };
+};
+
+#endif /* bbb_easing_table_hpp */
@@ -9,6 +9,12 @@
 #ifndef bbb_layout_hpp
 #define bbb_layout_hpp
 
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <utility>
+
 namespace bbb {
     namespace view_system {
         namespace layout {
@@ -46,8 +52,197 @@ namespace bbb {
                 float bottom;
                 float left;
             };
+            
+            // direction of stacking subviews. none: subviews aren't arranged.
+            enum class axis : std::uint8_t {
+                none,
+                horizontal,
+                vertical
+            };
+            
+            // on cross axis
+            enum class align : std::uint8_t {
+                start,
+                center,
+                end,
+                stretch
+            };
+            
+            // on main axis, for space left after grow
+            enum class justify : std::uint8_t {
+                start,
+                center,
+                end,
+                space_between
+            };
+            
+            // per view parameters. a view is container of its subviews and item of its parent.
+            struct params {
+                inline params &setDirection(axis direction) {
+                    this->direction = direction;
+                    return *this;
+                }
+                inline params &setSpacing(float spacing) {
+                    this->spacing = spacing;
+                    return *this;
+                }
+                inline params &setWrap(bool isWrapping) {
+                    this->isWrapping = isWrapping;
+                    return *this;
+                }
+                inline params &setAlignItems(align alignItems) {
+                    this->alignItems = alignItems;
+                    return *this;
+                }
+                inline params &setJustifyContent(justify justifyContent) {
+                    this->justifyContent = justifyContent;
+                    return *this;
+                }
+                template <typename ... arguments>
+                inline params &setPadding(arguments && ... args) {
+                    padding.set(std::forward<arguments>(args) ...);
+                    return *this;
+                }
+                inline params &setFitContent(bool isFittingContent) {
+                    this->isFittingContent = isFittingContent;
+                    return *this;
+                }
+                inline params &setGrow(float grow) {
+                    this->grow = grow;
+                    return *this;
+                }
+                inline params &setShrink(float shrink) {
+                    this->shrink = shrink;
+                    return *this;
+                }
+                inline params &setBasis(float basis) {
+                    this->basis = basis;
+                    return *this;
+                }
+                
+                inline bool isStacking() const { return direction != axis::none; };
+                
+                // as container
+                axis direction{axis::none};
+                float spacing{0.0f};
+                bool isWrapping{false};
+                align alignItems{align::start};
+                justify justifyContent{justify::start};
+                margin padding{0.0f};
+                bool isFittingContent{false}; // if false, preferred size is given frame
+                
+                // as item
+                float grow{0.0f};
+                float shrink{0.0f};
+                float basis{-1.0f}; // if negative, preferred size on main axis is used
+            };
+            
+            // item of stack. main / cross are preferred size, and x, y, width, height are result of arrange.
+            struct item {
+                float main;
+                float cross;
+                float grow;
+                float shrink;
+                
+                float x;
+                float y;
+                float width;
+                float height;
+            };
+            
+            // content size of items in one line, including padding
+            inline void measure(const params &p, const std::vector<item> &items, float &width, float &height) {
+                float main = 0.0f, cross = 0.0f;
+                for(auto &&i : items) {
+                    main += i.main;
+                    cross = (std::max)(cross, i.cross);
+                }
+                if(1 < items.size()) main += p.spacing * (items.size() - 1);
+                const bool isHorizontal = p.direction == axis::horizontal;
+                width = (isHorizontal ? main : cross) + p.padding.left + p.padding.right;
+                height = (isHorizontal ? cross : main) + p.padding.top + p.padding.bottom;
+            }
+            
+            // arranges items in area of width x height (including padding)
+            inline void arrange(const params &p, float width, float height, std::vector<item> &items) {
+                const bool isHorizontal = p.direction == axis::horizontal;
+                const auto &pad = p.padding;
+                const float mainSize = isHorizontal ? width - pad.left - pad.right : height - pad.top - pad.bottom;
+                const float crossSize = isHorizontal ? height - pad.top - pad.bottom : width - pad.left - pad.right;
+                const float mainStart = isHorizontal ? pad.left : pad.top;
+                const float crossStart = isHorizontal ? pad.top : pad.left;
+                
+                float crossOffset = 0.0f;
+                for(std::size_t begin = 0; begin < items.size();) {
+                    // [begin, end) is one line
+                    std::size_t end = begin + 1;
+                    float used = items[begin].main;
+                    while(end < items.size() && (!p.isWrapping || used + p.spacing + items[end].main <= mainSize)) {
+                        used += p.spacing + items[end].main;
+                        ++end;
+                    }
+                    
+                    // grow / shrink
+                    const float free = mainSize - used;
+                    float growSum = 0.0f, shrinkSum = 0.0f;
+                    for(std::size_t i = begin; i < end; ++i) {
+                        growSum += items[i].grow;
+                        shrinkSum += items[i].shrink * items[i].main;
+                    }
+                    float total = p.spacing * (end - begin - 1);
+                    float lineCross = 0.0f;
+                    for(std::size_t i = begin; i < end; ++i) {
+                        auto &&it = items[i];
+                        float size = it.main;
+                        if(0.0f < free && 0.0f < growSum) size += free * it.grow / growSum;
+                        else if(free < 0.0f && 0.0f < shrinkSum) size += free * it.shrink * it.main / shrinkSum;
+                        size = (std::max)(size, 0.0f);
+                        if(isHorizontal) it.width = size;
+                        else it.height = size;
+                        total += size;
+                        lineCross = (std::max)(lineCross, it.cross);
+                    }
+                    if(!p.isWrapping) lineCross = crossSize;
+                    
+                    // justify
+                    const float rest = (std::max)(mainSize - total, 0.0f);
+                    float position = mainStart, gap = p.spacing;
+                    switch(p.justifyContent) {
+                        case justify::start: break;
+                        case justify::center: position += rest * 0.5f; break;
+                        case justify::end: position += rest; break;
+                        case justify::space_between:
+                            if(1 < end - begin) gap += rest / (end - begin - 1);
+                            break;
+                    }
+                    
+                    // place and align
+                    for(std::size_t i = begin; i < end; ++i) {
+                        auto &&it = items[i];
+                        const float cross = p.alignItems == align::stretch ? lineCross : it.cross;
+                        float crossPosition = crossStart + crossOffset;
+                        if(p.alignItems == align::center) crossPosition += (lineCross - cross) * 0.5f;
+                        else if(p.alignItems == align::end) crossPosition += lineCross - cross;
+                        if(isHorizontal) {
+                            it.x = position;
+                            it.y = crossPosition;
+                            it.height = cross;
+                            position += it.width + gap;
+                        } else {
+                            it.x = crossPosition;
+                            it.y = position;
+                            it.width = cross;
+                            position += it.height + gap;
+                        }
+                    }
+                    
+                    crossOffset += lineCross + p.spacing;
+                    begin = end;
+                }
+            }
         };
     };
+    namespace vs = view_system;
 };
 
 #endif /* bbb_layout_hpp */
@@ -11,8 +11,10 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <new>
 #include <type_traits>
 #include <functional>
+#include <utility>
 
 namespace bbb {
     namespace opt_arg_function_detail {
@@ -128,107 +130,206 @@ namespace bbb {
             : detail::function_traits<ret, arguments ...> {};
         };
         
+        // nth<index>::get(args ...) returns index-th argument, without making tuple
+        template <std::size_t index>
+        struct nth {
+            template <typename head, typename ... rest>
+            static auto get(head &&, rest && ... r)
+                -> decltype(nth<index - 1>::get(std::forward<rest>(r) ...))
+            { return nth<index - 1>::get(std::forward<rest>(r) ...); };
+        };
+        template <>
+        struct nth<0> {
+            template <typename head, typename ... rest>
+            static head &&get(head &&h, rest && ...) { return std::forward<head>(h); };
+        };
+        
+        // function pointer or class with (non template) operator(), which takes at most max_arity arguments
+        template <
+            typename callable_t,
+            std::size_t max_arity,
+            bool = (std::is_pointer<callable_t>::value && std::is_function<typename std::remove_pointer<callable_t>::type>::value)
+                || has_call_operator<callable_t>::value
+        >
+        struct is_acceptable : std::false_type {};
+        template <typename callable_t, std::size_t max_arity>
+        struct is_acceptable<callable_t, max_arity, true>
+        : std::integral_constant<bool, function_traits<callable_t>::arity <= max_arity> {};
+        
         template <typename function_type>
         struct opt_arg_function;
         
+        // callable with small buffer.
+        // callable which takes first n arguments of signature (n <= arity) is accepted,
+        // and dropped arguments are resolved at compile time.
+        // callable larger than buffer_size is stored on heap.
         template <typename res, typename ... arguments>
         struct opt_arg_function<res(arguments ...)> {
             using function_type = std::function<res(arguments ...)>;
+            enum : std::size_t { buffer_size = 4 * sizeof(void *) };
+            
+            opt_arg_function() {};
+            
+            opt_arg_function(const opt_arg_function &f)
+            : invoker(f.invoker)
+            , manager(f.manager)
+            {
+                if(manager) manager(operation::copy, storage, f.storage);
+                else storage = f.storage;
+            };
+            opt_arg_function(opt_arg_function &&f) noexcept
+            : invoker(f.invoker)
+            , manager(f.manager)
+            {
+                if(manager) manager(operation::move, storage, f.storage);
+                else storage = f.storage;
+                f.invoker = &default_invoke;
+                f.manager = nullptr;
+            };
             
-            opt_arg_function()
-            : f([](arguments ...) -> res { return {}; }) {};
-            
-            opt_arg_function(const opt_arg_function &) = default;
-            opt_arg_function(opt_arg_function &&) = default;
-            
-            opt_arg_function(const function_type &f)
-            : f(f) {};
-            opt_arg_function(function_type &&f)
-            : f(std::move(f)) {};
-            
-            template <typename res_, typename ... arguments_>
-            opt_arg_function(const std::function<res_(arguments_ ...)> &f_)
-            : f(opt_arg_function::convert(f_, make_index_sequence<sizeof...(arguments_)>()))
-            {};
-            template <typename res_, typename ... arguments_>
-            opt_arg_function(std::function<res_(arguments_ ...)> &&f_)
-            : f(opt_arg_function::convert(std::move(f_), make_index_sequence<sizeof...(arguments_)>()))
-            {};
             template <
-                typename function_type,
+                typename callable_type,
                 typename = typename std::enable_if<
-                    !is_function<function_type>::value &&
-                    has_call_operator<function_type>::value
+                    !std::is_same<typename std::decay<callable_type>::type, opt_arg_function>::value &&
+                    is_acceptable<typename std::decay<callable_type>::type, sizeof...(arguments)>::value
                 >::type
             >
-            opt_arg_function(function_type f)
-            : opt_arg_function(function_traits<function_type>::cast(f)){};
-            
-            opt_arg_function &operator=(const opt_arg_function &) = default;
-            opt_arg_function &operator=(opt_arg_function &&) = default;
-            
-            opt_arg_function &operator=(const function_type &f) { this->f = f; return *this; };
-            opt_arg_function &operator=(function_type &&f) { this->f = std::move(f); return *this; };
-            
-            template <typename function_type>
-            auto operator=(function_type f)
-            -> typename std::enable_if<
-            !is_function<function_type>::value &&
-            has_call_operator<function_type>::value,
-            opt_arg_function &
-            >::type
-            { return operator=(function_traits<function_type>::cast(f)); };
-            
-            template <typename res_, typename ... arguments_>
-            opt_arg_function &operator=(const std::function<res_(arguments_ ...)> &f) {
-                this->f = opt_arg_function::convert(f, make_index_sequence<sizeof...(arguments_)>());
+            opt_arg_function(callable_type &&f) {
+                using callable_t = typename std::decay<callable_type>::type;
+                using ops = storage_ops<callable_t>;
+                ops::create(storage, std::forward<callable_type>(f));
+                invoker = &invoker_of<callable_t, make_index_sequence<function_traits<callable_t>::arity>>::invoke;
+                manager = ops::trivial ? nullptr : &ops::manage;
+            };
+            
+            ~opt_arg_function() { reset(); };
+            
+            opt_arg_function &operator=(const opt_arg_function &f) {
+                if(this != &f) {
+                    opt_arg_function tmp(f);
+                    *this = std::move(tmp);
+                }
                 return *this;
             };
-            template <typename res_, typename ... arguments_>
-            opt_arg_function &operator=(std::function<res_(arguments_ ...)> &&f) {
-                this->f = opt_arg_function::convert(std::move(f), make_index_sequence<sizeof...(arguments_)>());
+            opt_arg_function &operator=(opt_arg_function &&f) noexcept {
+                if(this != &f) {
+                    reset();
+                    invoker = f.invoker;
+                    manager = f.manager;
+                    if(manager) manager(operation::move, storage, f.storage);
+                    else storage = f.storage;
+                    f.invoker = &default_invoke;
+                    f.manager = nullptr;
+                }
                 return *this;
             };
+            template <
+                typename callable_type,
+                typename = typename std::enable_if<
+                    !std::is_same<typename std::decay<callable_type>::type, opt_arg_function>::value &&
+                    is_acceptable<typename std::decay<callable_type>::type, sizeof...(arguments)>::value
+                >::type
+            >
+            opt_arg_function &operator=(callable_type &&f)
+            { return operator=(opt_arg_function(std::forward<callable_type>(f))); };
             
             template <typename ... other_arguments>
-            res operator()(arguments ... args, other_arguments && ...) const { return f(std::forward<arguments>(args) ...); };
+            res operator()(arguments ... args, other_arguments && ...) const
+            { return invoker(storage, std::forward<arguments>(args) ...); };
             
-            operator std::function<res(arguments ...)>() const { return f; };
+            operator std::function<res(arguments ...)>() const { return as(); };
             
             template <typename ... other_arguments>
             operator std::function<res(arguments ..., other_arguments && ...)>() const {
-                auto &&f_ = f;
-                return [f_](arguments ... args, other_arguments && ...) -> res { return f_(args ...); };
+                const opt_arg_function f_ = *this;
+                return [f_](arguments ... args, other_arguments && ...) -> res { return f_(std::forward<arguments>(args) ...); };
             };
             
-            std::function<res(arguments ...)> as() const { return f; };
+            std::function<res(arguments ...)> as() const {
+                const opt_arg_function f_ = *this;
+                return [f_](arguments ... args) -> res { return f_(std::forward<arguments>(args) ...); };
+            };
             
             template <typename function_type_>
             std::function<function_type_> as() const { return std::function<function_type_>(*this); };
+            
         private:
-            template <typename res_, typename ... arguments_, std::size_t ... indices>
-            static auto convert(std::function<res_(arguments_ ...)> f,
-                                index_sequence<indices ...> &&)
-                -> enable_if_t<sizeof...(arguments_) <= sizeof...(arguments), function_type>
-            {
-                return [f](arguments ... args) {
-                    return static_cast<res>(f(get<indices>(std::forward<arguments>(args) ...) ...));
+            using storage_t = typename std::aligned_storage<buffer_size, alignof(std::max_align_t)>::type;
+            enum class operation { copy, move, destroy };
+            using invoker_t = res (*)(storage_t &, arguments && ...);
+            using manager_t = void (*)(operation, storage_t &, const storage_t &);
+            
+            template <typename callable_t,
+                      bool = sizeof(callable_t) <= sizeof(storage_t)
+                          && alignof(storage_t) % alignof(callable_t) == 0
+                          && std::is_nothrow_move_constructible<callable_t>::value>
+            struct storage_ops {
+                static constexpr bool trivial = std::is_trivially_copyable<callable_t>::value;
+                static callable_t &get(storage_t &s) { return *reinterpret_cast<callable_t *>(&s); };
+                static const callable_t &get(const storage_t &s) { return *reinterpret_cast<const callable_t *>(&s); };
+                template <typename callable_type>
+                static void create(storage_t &s, callable_type &&f) { new(&s) callable_t(std::forward<callable_type>(f)); };
+                static void manage(operation op, storage_t &dst, const storage_t &src) {
+                    switch(op) {
+                        case operation::copy:
+                            new(&dst) callable_t(get(src));
+                            break;
+                        case operation::move: {
+                            callable_t &from = get(const_cast<storage_t &>(src));
+                            new(&dst) callable_t(std::move(from));
+                            from.~callable_t();
+                            break;
+                        }
+                        case operation::destroy:
+                            get(dst).~callable_t();
+                            break;
+                    }
                 };
             };
             
-            template <std::size_t index>
-            static auto get(arguments ... args)
-                -> typename std::tuple_element<index, std::tuple<arguments && ...>>::type
-            {
-                return std::forward<
-                    typename std::tuple_element<
-                        index,
-                        std::tuple<arguments && ...>
-                    >::type
-                >(std::get<index>(std::tuple<arguments && ...>(std::forward<arguments>(args) ...)));
+            template <typename callable_t>
+            struct storage_ops<callable_t, false> {
+                static constexpr bool trivial = false;
+                static callable_t *&pointer(storage_t &s) { return *reinterpret_cast<callable_t **>(&s); };
+                static callable_t *pointer(const storage_t &s) { return *reinterpret_cast<callable_t * const *>(&s); };
+                static callable_t &get(storage_t &s) { return *pointer(s); };
+                template <typename callable_type>
+                static void create(storage_t &s, callable_type &&f) { pointer(s) = new callable_t(std::forward<callable_type>(f)); };
+                static void manage(operation op, storage_t &dst, const storage_t &src) {
+                    switch(op) {
+                        case operation::copy:
+                            pointer(dst) = new callable_t(*pointer(src));
+                            break;
+                        case operation::move:
+                            pointer(dst) = pointer(src);
+                            break;
+                        case operation::destroy:
+                            delete pointer(dst);
+                            break;
+                    }
+                };
+            };
+            
+            template <typename callable_t, typename sequence>
+            struct invoker_of;
+            template <typename callable_t, std::size_t ... indices>
+            struct invoker_of<callable_t, index_sequence<indices ...>> {
+                static res invoke(storage_t &s, arguments && ... args) {
+                    return static_cast<res>(storage_ops<callable_t>::get(s)(nth<indices>::get(std::forward<arguments>(args) ...) ...));
+                };
+            };
+            
+            static res default_invoke(storage_t &, arguments && ...) { return res(); };
+            
+            inline void reset() {
+                if(manager) manager(operation::destroy, storage, storage);
+                invoker = &default_invoke;
+                manager = nullptr;
             };
             
-            function_type f;
+            mutable storage_t storage{};
+            invoker_t invoker{&default_invoke};
+            manager_t manager{nullptr};
         };
     };
     using opt_arg_function_detail::opt_arg_function;
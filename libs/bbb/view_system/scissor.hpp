@@ -0,0 +1,47 @@
+//
+//  scissor.hpp
+//
+//  Created by ISHII 2bit on 2018/03/20.
+//
+
+#pragma once
+
+#ifndef bbb_scissor_hpp
+#define bbb_scissor_hpp
+
+#include "ofGraphics.h"
+#include "ofAppRunner.h"
+#include "ofRectangle.h"
+
+namespace bbb {
+    namespace view_system {
+        // restricts drawing to rect (in window coordinate) while alive.
+        // previous scissor state is restored on destruction, so it can be nested.
+        struct scoped_scissor {
+            scoped_scissor(const ofRectangle &rect)
+            : wasEnabled(glIsEnabled(GL_SCISSOR_TEST))
+            {
+                glGetIntegerv(GL_SCISSOR_BOX, previousBox);
+                glEnable(GL_SCISSOR_TEST);
+                glScissor(static_cast<GLint>(rect.getMinX()),
+                          static_cast<GLint>(ofGetHeight() - rect.getMaxY()),
+                          static_cast<GLsizei>(rect.getWidth() < 0.0f ? 0.0f : rect.getWidth()),
+                          static_cast<GLsizei>(rect.getHeight() < 0.0f ? 0.0f : rect.getHeight()));
+            };
+            ~scoped_scissor() {
+                glScissor(previousBox[0], previousBox[1], previousBox[2], previousBox[3]);
+                if(!wasEnabled) glDisable(GL_SCISSOR_TEST);
+            };
+
+            scoped_scissor(const scoped_scissor &) = delete;
+            scoped_scissor &operator=(const scoped_scissor &) = delete;
+
+        private:
+            GLboolean wasEnabled;
+            GLint previousBox[4];
+        };
+    };
+    namespace vs = view_system;
+};
+
+#endif /* bbb_scissor_hpp */
@@ -0,0 +1,116 @@
+//
+//  spatial_index.hpp
+//
+//  Created by ISHII 2bit on 2018/03/20.
+//
+
+#pragma once
+
+#ifndef bbb_spatial_index_hpp
+#define bbb_spatial_index_hpp
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+
+#include "ofRectangle.h"
+#include "ofPoint.h"
+
+namespace bbb {
+    namespace view_system {
+        // uniform grid over rectangles.
+        // each cell keeps its elements sorted by given order, so query result can be used as is.
+        template <typename element_type>
+        struct uniform_grid {
+            using element_list = std::vector<element_type *>;
+
+            explicit uniform_grid(float cell_size = 64.0f)
+            : cell_size(0.0f < cell_size ? cell_size : 64.0f) {};
+
+            inline float getCellSize() const { return cell_size; };
+
+            template <typename compare_t>
+            inline void insert(element_type *e, const ofRectangle &rect, compare_t comp) {
+                const cell_range r = range_of(rect);
+                ranges[e] = r;
+                for(std::int32_t y = r.y0; y <= r.y1; ++y) {
+                    for(std::int32_t x = r.x0; x <= r.x1; ++x) {
+                        auto &cell = cells[key(x, y)];
+                        cell.insert(std::upper_bound(cell.begin(), cell.end(), e, comp), e);
+                    }
+                }
+            }
+
+            template <typename compare_t>
+            inline void update(element_type *e, const ofRectangle &rect, compare_t comp) {
+                auto it = ranges.find(e);
+                if(it != ranges.end() && it->second == range_of(rect)) return;
+                remove(e);
+                insert(e, rect, comp);
+            }
+
+            inline void remove(element_type *e) {
+                auto it = ranges.find(e);
+                if(it == ranges.end()) return;
+                const cell_range r = it->second;
+                ranges.erase(it);
+                for(std::int32_t y = r.y0; y <= r.y1; ++y) {
+                    for(std::int32_t x = r.x0; x <= r.x1; ++x) {
+                        auto cell = cells.find(key(x, y));
+                        if(cell == cells.end()) continue;
+                        auto &&list = cell->second;
+                        list.erase(std::remove(list.begin(), list.end(), e), list.end());
+                        if(list.empty()) cells.erase(cell);
+                    }
+                }
+            }
+
+            inline bool contains(const element_type *e) const
+            { return ranges.find(const_cast<element_type *>(e)) != ranges.end(); };
+
+            inline void clear() {
+                cells.clear();
+                ranges.clear();
+            }
+
+            inline const element_list &query(const ofPoint &p) const {
+                static const element_list empty;
+                auto it = cells.find(key(cell_of(p.x), cell_of(p.y)));
+                return (it == cells.end()) ? empty : it->second;
+            }
+
+            // cell containing p. elements out of query(p) don't overlap it.
+            inline ofRectangle cellRect(const ofPoint &p) const
+            { return ofRectangle(cell_of(p.x) * cell_size, cell_of(p.y) * cell_size, cell_size, cell_size); };
+
+        private:
+            struct cell_range {
+                std::int32_t x0, y0, x1, y1;
+                inline bool operator==(const cell_range &r) const
+                { return x0 == r.x0 && y0 == r.y0 && x1 == r.x1 && y1 == r.y1; };
+            };
+
+            inline std::int32_t cell_of(float v) const
+            { return static_cast<std::int32_t>(std::floor(v / cell_size)); };
+
+            inline cell_range range_of(const ofRectangle &rect) const {
+                return {
+                    cell_of(rect.getMinX()), cell_of(rect.getMinY()),
+                    cell_of(rect.getMaxX()), cell_of(rect.getMaxY())
+                };
+            }
+
+            static inline std::uint64_t key(std::int32_t x, std::int32_t y)
+            { return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y); };
+
+            float cell_size;
+            std::unordered_map<std::uint64_t, element_list> cells;
+            std::unordered_map<element_type *, cell_range> ranges;
+        };
+    };
+    namespace vs = view_system;
+};
+
+#endif /* bbb_spatial_index_hpp */
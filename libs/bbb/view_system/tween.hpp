@@ -0,0 +1,220 @@
+//
+//  tween.hpp
+//
+//  Created by ISHII 2bit on 2018/03/21.
+//
+
+#pragma once
+
+#ifndef bbb_tween_hpp
+#define bbb_tween_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "animation.hpp"
+#include "easing.hpp"
+#include "easing_table.hpp"
+
+namespace bbb {
+    namespace view_system {
+        // typed tweens of a property.
+        // property is a type like below, and all tweens of a property are stored as plain data in one batch.
+        //
+        //     struct property {
+        //         using target_type = ...;
+        //         using value_type = ...;
+        //         static std::string label(const target_type &); // passed to finish callback
+        //         static value_type get(const target_type &);
+        //         static void set(target_type &, const value_type &);
+        //         static value_type interpolate(const value_type &from, const value_type &to, float t);
+        //     };
+        namespace tween {
+            using finish_callback_t = animation::finish_callback_t;
+
+            // one tween per target. new tween of same target replaces running one.
+            // target is referred by raw pointer, so it has to be cancelled before target is destroyed.
+            // (view cancels its tweens on destruction)
+            template <typename property>
+            struct batch : public animation::batch {
+                using target_type = typename property::target_type;
+                using target_ref = target_type *;
+                using value_type = typename property::value_type;
+
+                static batch &get() {
+                    static batch _;
+                    return _;
+                }
+
+                inline void add(target_ref target,
+                                const value_type &from,
+                                const value_type &to,
+                                float duration,
+                                easing::curve easing,
+                                float delay,
+                                finish_callback_t finish)
+                {
+                    const float startTime = animation::manager::get().now() + delay;
+                    const float inverseDuration = duration <= 0.0f ? 0.0f : 1.0f / duration;
+                    auto it = indices.find(target);
+                    if(it != indices.end()) {
+                        const std::size_t i = it->second;
+                        froms[i] = from;
+                        tos[i] = to;
+                        startTimes[i] = startTime;
+                        inverseDurations[i] = inverseDuration;
+                        easings[i] = easing;
+                        // replaced callback is destroyed on return (see erase)
+                        std::swap(finishCallbacks[i], finish);
+                        return;
+                    }
+                    indices[target] = targets.size();
+                    targets.push_back(target);
+                    froms.push_back(from);
+                    tos.push_back(to);
+                    startTimes.push_back(startTime);
+                    inverseDurations.push_back(inverseDuration);
+                    progresses.push_back(0.0f);
+                    easings.push_back(easing);
+                    finishCallbacks.push_back(std::move(finish));
+                }
+
+                inline void cancel(const target_type *target) {
+                    auto it = indices.find(target);
+                    if(it != indices.end()) erase(it->second);
+                }
+
+                inline bool isRunning(const target_type *target) const
+                { return indices.find(target) != indices.end(); };
+
+                virtual std::size_t size() const override { return targets.size(); };
+                virtual void cancelTarget(const void *target) override
+                { cancel(static_cast<const target_type *>(target)); };
+
+                virtual void update(float currentTime) override {
+                    const std::size_t num = targets.size();
+                    for(std::size_t i = 0; i < num; ++i) {
+                        const float t = (currentTime - startTimes[i]) * inverseDurations[i];
+                        progresses[i] = (currentTime < startTimes[i]) ? -1.0f
+                                      : (inverseDurations[i] == 0.0f || 1.0f <= t) ? 1.0f
+                                      : t;
+                    }
+                    // evaluates easing by array version for each run of same easing
+                    eased.resize(num);
+                    for(std::size_t i = 0; i < num;) {
+                        std::size_t j = i + 1;
+                        while(j < num && easings[j] == easings[i]) ++j;
+                        easings[i](progresses.data() + i, eased.data() + i, j - i);
+                        i = j;
+                    }
+                    for(std::size_t i = 0; i < num; ++i) {
+                        if(progresses[i] < 0.0f) continue;
+                        property::set(*targets[i], property::interpolate(froms[i], tos[i], eased[i]));
+                    }
+
+                    // finish callbacks can add tweens to this batch, so they are called after erasing
+                    for(std::size_t i = num; 0 < i--;) {
+                        if(progresses[i] < 1.0f) continue;
+                        // label is made here, because target can be destroyed by other finish callbacks
+                        finishing.push_back({property::label(*targets[i]), std::move(finishCallbacks[i])});
+                        erase(i);
+                    }
+                    for(auto &&f : finishing) f.callback(f.label);
+                    finishing.clear();
+                }
+
+            private:
+                batch() { animation::manager::get().addBatch(this); };
+                virtual ~batch() { animation::manager::get().removeBatch(this); };
+
+                // swap with last and pop.
+                // finish callback can hold last reference of a view, and its destructor cancels tweens.
+                // so it is destroyed on return, after arrays get consistent.
+                inline void erase(std::size_t i) {
+                    finish_callback_t finishCallback;
+                    std::swap(finishCallback, finishCallbacks[i]);
+                    const std::size_t last = targets.size() - 1;
+                    indices.erase(targets[i]);
+                    if(i != last) {
+                        targets[i] = targets[last];
+                        froms[i] = froms[last];
+                        tos[i] = tos[last];
+                        startTimes[i] = startTimes[last];
+                        inverseDurations[i] = inverseDurations[last];
+                        progresses[i] = progresses[last];
+                        easings[i] = easings[last];
+                        finishCallbacks[i] = std::move(finishCallbacks[last]);
+                        indices[targets[i]] = i;
+                    }
+                    targets.pop_back();
+                    froms.pop_back();
+                    tos.pop_back();
+                    startTimes.pop_back();
+                    inverseDurations.pop_back();
+                    progresses.pop_back();
+                    easings.pop_back();
+                    finishCallbacks.pop_back();
+                }
+
+                std::vector<target_ref> targets;
+                std::vector<value_type> froms;
+                std::vector<value_type> tos;
+                std::vector<float> startTimes;
+                std::vector<float> inverseDurations;
+                std::vector<float> progresses;
+                std::vector<float> eased;
+                std::vector<easing::curve> easings;
+                std::vector<finish_callback_t> finishCallbacks;
+                std::unordered_map<const target_type *, std::size_t> indices;
+
+                struct finishing_tween {
+                    std::string label;
+                    finish_callback_t callback;
+                };
+                std::vector<finishing_tween> finishing;
+            };
+
+            template <typename property>
+            inline void from_to(typename property::target_type *target,
+                                const typename property::value_type &from,
+                                const typename property::value_type &to,
+                                float duration,
+                                easing::curve easing = easing::type::linear,
+                                float delay = 0.0f,
+                                finish_callback_t finish = [](const std::string &) {})
+            {
+                batch<property>::get().add(target, from, to, duration, easing, delay, std::move(finish));
+            }
+
+            // starts from current value
+            template <typename property>
+            inline void to(typename property::target_type *target,
+                           const typename property::value_type &to,
+                           float duration,
+                           easing::curve easing = easing::type::linear,
+                           float delay = 0.0f,
+                           finish_callback_t finish = [](const std::string &) {})
+            {
+                const typename property::value_type from = property::get(*target);
+                from_to<property>(target, from, to, duration, easing, delay, std::move(finish));
+            }
+
+            template <typename property>
+            inline void cancel(const typename property::target_type *target) {
+                batch<property>::get().cancel(target);
+            }
+
+            template <typename property>
+            inline bool isRunning(const typename property::target_type *target) {
+                return batch<property>::get().isRunning(target);
+            }
+        };
+    };
+    namespace vs = view_system;
+};
+
+#endif /* bbb_tween_hpp */
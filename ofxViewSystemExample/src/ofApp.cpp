@@ -47,13 +47,13 @@ class ofApp : public ofBaseApp {
             c.b = 255 - c.b;
         });
         root->onWindowResized(bbb::vs::fitToParent);
-        root->onMouseOver([](bbb::vs::mouse_event_arg arg) {
-            auto &&v = arg.target;
-            if(v->isClickedNow()) {
-                v->move(v->mouseDelta());
-            }
+        // root captures pointer when pressed, so drag is dispatched only to it
+        root->onDrag([](bbb::vs::mouse_event_arg arg) {
+            arg.target->move(arg.delta);
         });
         root->registerEvents();
+        // moves are dispatched once per frame
+        bbb::vs::event_router::get().setCoalescing(true);
         addSubview();
     }
     
@@ -87,7 +87,9 @@ class ofApp : public ofBaseApp {
             .setBackgroundColor(1.0f, 1.0f, 1.0f, 0.5f)
             .setEventTransparent(true);
         
-        auto &&subview = std::make_shared<CustomView>(setting);
+        // subview and its children are allocated together, and released at once when subview is closed
+        bbb::vs::scoped_arena scope(bbb::vs::arena::create(16));
+        auto &&subview = bbb::vs::make_view<CustomView>(setting);
         
         auto &&closeButton = createCloseButton();
         closeButton->setPosition({subview->getWidth() - 10.0f, -10.0f});
@@ -0,0 +1,20 @@
+#include "test.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<std::size_t> counter{0};
+};
+
+void *operator new(std::size_t size) {
+    counter.fetch_add(1, std::memory_order_relaxed);
+    if(void *p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+
+std::size_t bbb::test::numAllocations() {
+    return counter.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,69 @@
+#include "test.hpp"
+
+#include <vector>
+
+#include "bbb/view_system/components/view.hpp"
+
+BBB_TEST(animation_cancel_by_owner) {
+    using namespace bbb::vs;
+    auto &&manager = animation::manager::get();
+    manager.setClockMode(animation::clock_mode::manual);
+    const std::size_t numBefore = manager.size();
+    
+    auto panel = view::create(ofRectangle());
+    std::vector<view::ref> children;
+    for(int i = 0; i < 100; ++i) {
+        children.push_back(view::create(ofRectangle()));
+        panel->add(children.back());
+        children.back()->animate([](float) {}, 10.0f);
+        children.back()->fadeTo(0.0f, 10.0f);
+    }
+    int numFinished = 0;
+    auto other = animation::add([](float) {}, 10.0f, [&numFinished] { ++numFinished; });
+    // tweens of fadeTo are in batch, not counted by size
+    BBB_CHECK(manager.size() == numBefore + 101);
+    
+    // subtree, without finish callbacks
+    panel->cancelAnimations(true);
+    BBB_CHECK(manager.size() == numBefore + 1);
+    BBB_CHECK(manager.isRunning(other));
+    
+    // destruction of owner
+    auto v = view::create(ofRectangle());
+    auto h = v->animate([](float) {}, 10.0f);
+    v.reset();
+    BBB_CHECK(!manager.isRunning(h));
+    
+    manager.step(100.0f);
+    BBB_CHECK(numFinished == 1 && manager.size() == numBefore);
+    bool isFadeCancelled = true;
+    for(auto &&child : children) isFadeCancelled = isFadeCancelled && child->getAlpha() == 1.0f;
+    BBB_CHECK(isFadeCancelled);
+}
+
+BBB_TEST(animation_erase_releases_last_owner) {
+    using namespace bbb::vs;
+    auto &&manager = animation::manager::get();
+    manager.setClockMode(animation::clock_mode::manual);
+    const std::size_t numBefore = manager.size();
+    
+    for(int round = 0; round < 3; ++round) {
+        std::vector<animation::handle> handles;
+        for(int i = 0; i < 200; ++i) {
+            auto v = view::create(ofRectangle());
+            // view owns animations, and finish callback of other animation owns the view.
+            // erasing the callback destroys the view, which cancels its animations while erasing.
+            v->animate([](float) {}, 10.0f);
+            v->fadeTo(0.5f, 10.0f);
+            handles.push_back(animation::add([](float) {}, 10.0f, [v](const std::string &) {}));
+            animation::add([](float) {}, 10.0f);
+        }
+        BBB_CHECK(manager.size() == numBefore + 600);
+        if(round == 0) for(auto &&h : handles) animation::remove(h);
+        if(round == 1) for(auto it = handles.rbegin(); it != handles.rend(); ++it) animation::remove(*it);
+        if(round < 2) BBB_CHECK(manager.size() == numBefore + 200);
+        // by finishing
+        manager.step(100.0f);
+        BBB_CHECK(manager.size() == numBefore);
+    }
+}
@@ -0,0 +1,78 @@
+#include "test.hpp"
+
+#include <vector>
+
+#include "bbb/view_system/animation.hpp"
+
+namespace {
+    struct chain_state {
+        std::vector<int> links; // number of finished links per chain
+        std::vector<float> lastProgresses;
+        std::size_t numBackwards{0};
+        std::size_t numCallbacksOfCancelled{0};
+        std::vector<bbb::vs::animation::handle> cancelled;
+    };
+    
+    const int numLinks = 4;
+    
+    // each link adds next link of same chain from its finish callback, i.e. while manager is updating
+    void addLink(chain_state &state, std::size_t chain) {
+        auto &&manager = bbb::vs::animation::manager::get();
+        state.lastProgresses[chain] = 0.0f;
+        manager.add([&state, chain](float progress) {
+            if(progress < state.lastProgresses[chain]) ++state.numBackwards;
+            state.lastProgresses[chain] = progress;
+        }, 0.05f + 0.01f * (chain % 5), 0.0f, std::string(), [&state, chain] {
+            if(++state.links[chain] < numLinks) addLink(state, chain);
+        });
+    }
+};
+
+BBB_TEST(animation_chain_stress) {
+    using namespace bbb::vs;
+    const std::size_t numChains = 100000;
+    auto &&manager = animation::manager::get();
+    manager.setClockMode(animation::clock_mode::manual);
+    manager.setAutoUpdate(false);
+    manager.reserve(2 * numChains);
+    
+    chain_state state;
+    state.links.assign(numChains, 0);
+    state.lastProgresses.assign(numChains, 0.0f);
+    state.cancelled.reserve(numChains);
+    for(std::size_t chain = 0; chain < numChains; ++chain) addLink(state, chain);
+    
+    // animations removed by callbacks of others while updating. they never finish.
+    for(std::size_t i = 0; i < numChains / 10; ++i) {
+        state.cancelled.push_back(manager.add([&state](float) { ++state.numCallbacksOfCancelled; }, 10.0f, 0.0f, std::string(), [] {}));
+    }
+    manager.add([&state](float progress) {
+        if(progress < 0.5f) return;
+        for(auto &&h : state.cancelled) animation::remove(h);
+    }, 0.02f, 0.0f, std::string(), [] {});
+    
+    // first frame reaches capacity of buffers
+    manager.step(1.0f / 60.0f);
+    
+    const std::size_t numAllocationsBefore = bbb::test::numAllocations();
+    std::size_t numFrames = 0;
+    while(manager.size() && numFrames < 1000) {
+        manager.step(1.0f / 60.0f);
+        ++numFrames;
+    }
+    const std::size_t numAllocations = bbb::test::numAllocations() - numAllocationsBefore;
+    
+    std::size_t numCompleted = 0;
+    for(auto &&n : state.links) if(n == numLinks) ++numCompleted;
+    std::printf("  %zu frames, %zu allocations while chaining\n", numFrames, numAllocations);
+    BBB_CHECK(manager.size() == 0);
+    BBB_CHECK(numCompleted == numChains);
+    BBB_CHECK(state.numBackwards == 0);
+    BBB_CHECK(numAllocations == 0);
+    for(auto &&h : state.cancelled) BBB_CHECK(!manager.isRunning(h));
+    // removed in the frame of progress 0.5, so they were called in at most 2 frames
+    BBB_CHECK(state.numCallbacksOfCancelled <= 2 * state.cancelled.size());
+    
+    manager.setClockMode(animation::clock_mode::real);
+    manager.setAutoUpdate(true);
+}
@@ -0,0 +1,115 @@
+#include "test.hpp"
+
+#include <string>
+
+#include "bbb/view_system/components/view.hpp"
+
+namespace {
+    using namespace bbb::vs;
+    
+    // overrides drawing of whole subtree, e.g. for wrapping it by some state
+    struct wrapping_view : view {
+        using view::view;
+        std::string *log{nullptr};
+        
+        virtual void drawTree(const ofRectangle &visibleRect) override {
+            if(log) *log += "(";
+            view::drawTree(visibleRect);
+            if(log) *log += ")";
+        }
+    };
+    
+    struct logging_view : view {
+        using view::view;
+        std::string *log{nullptr};
+        char mark{'?'};
+        
+        virtual void drawInternal() override { if(log) *log += mark; };
+    };
+};
+
+BBB_TEST(draw_calls_overridden_draw_tree_of_subviews) {
+    std::string log;
+    auto root = view::create(0, 0, 400, 400);
+    auto wrapping = std::make_shared<wrapping_view>(ofRectangle(0, 0, 100, 100));
+    wrapping->log = &log;
+    for(char mark : {'a', 'b'}) {
+        auto v = std::make_shared<logging_view>(ofRectangle(0, 0, 10, 10));
+        v->log = &log;
+        v->mark = mark;
+        wrapping->add(v);
+    }
+    root->add(wrapping);
+    root->draw(ofRectangle(0, 0, 400, 400));
+    BBB_CHECK(log == "(ab)");
+}
+
+namespace {
+    using namespace bbb::vs;
+    
+    // remembers state of batch when its custom drawing is called
+    struct batch_peeking_view : view {
+        using view::view;
+        const background_batch *batch{nullptr};
+        std::size_t numQuadsAtDraw{0};
+        std::size_t numFlushesAtDraw{0};
+        
+        virtual void drawInternal() override {
+            numQuadsAtDraw = batch->getNumQuads();
+            numFlushesAtDraw = batch->getNumFlushes();
+        };
+    };
+    
+    bool hasQuad(const background_batch &batch, std::size_t i, const ofRectangle &rect, const ofFloatColor &color) {
+        auto &&mesh = batch.getMesh();
+        const ofFloatColor &c = mesh.getColor(i * 6);
+        return mesh.getVertex(i * 6) == ofPoint(rect.getMinX(), rect.getMinY())
+            && mesh.getVertex(i * 6 + 2) == ofPoint(rect.getMaxX(), rect.getMaxY())
+            && c.r == color.r && c.g == color.g && c.b == color.b && c.a == color.a;
+    }
+};
+
+BBB_TEST(draw_background_batch_follows_paint_order) {
+    auto root = view::create(0, 0, 400, 400);
+    root->setBackgroundColor(1.0f, 0.0f, 0.0f);
+    auto group = view::create(10, 10, 100, 100);
+    group->setBackgroundColor(0.0f, 1.0f, 0.0f);
+    group->setAlpha(0.5f);
+    group->setClipSubviews(true);
+    auto inner = view::create(50, 50, 100, 100);
+    inner->setBackgroundColor(0.0f, 0.0f, 1.0f);
+    inner->setAlpha(0.5f);
+    group->add(inner);
+    auto custom = std::make_shared<batch_peeking_view>(ofRectangle(200, 10, 50, 50));
+    custom->setBackgroundColor(1.0f, 1.0f, 1.0f, 0.5f);
+    auto after = view::create(200, 100, 20, 20);
+    after->setBackgroundColor(0.0f, 0.0f, 0.0f);
+    auto hidden = view::create(300, 300, 20, 20);
+    hidden->setBackgroundColor(0.0f, 0.0f, 0.0f);
+    hidden->setAlpha(0.0f);
+    root->add(group);
+    root->add(custom);
+    root->add(after);
+    root->add(hidden);
+    
+    // alpha is multiplied through ancestors, and quad of clipped view is cut by frame of clipping one
+    background_batch batch;
+    root->buildBackgroundBatch(batch, ofRectangle(0, 0, 400, 400));
+    BBB_CHECK(batch.getNumQuads() == 5);
+    BBB_CHECK(hasQuad(batch, 0, ofRectangle(0, 0, 400, 400), ofFloatColor(1.0f, 0.0f, 0.0f, 1.0f)));
+    BBB_CHECK(hasQuad(batch, 1, ofRectangle(10, 10, 100, 100), ofFloatColor(0.0f, 1.0f, 0.0f, 0.5f)));
+    BBB_CHECK(hasQuad(batch, 2, ofRectangle(60, 60, 50, 50), ofFloatColor(0.0f, 0.0f, 1.0f, 0.25f)));
+    BBB_CHECK(hasQuad(batch, 3, ofRectangle(200, 10, 50, 50), ofFloatColor(1.0f, 1.0f, 1.0f, 0.5f)));
+    BBB_CHECK(hasQuad(batch, 4, ofRectangle(200, 100, 20, 20), ofFloatColor(0.0f, 0.0f, 0.0f, 1.0f)));
+    BBB_CHECK(batch.getNumFlushes() == 0);
+    BBB_CHECK(custom->numQuadsAtDraw == 0);
+    
+    // custom drawing flushes quads behind it (including its own background) first, and the rest is flushed at last
+    batch.clear();
+    custom->batch = &batch;
+    root->drawBatched(batch, ofRectangle(0, 0, 400, 400));
+    BBB_CHECK(custom->numQuadsAtDraw == 0);
+    BBB_CHECK(custom->numFlushesAtDraw == 1);
+    BBB_CHECK(batch.getNumFlushes() == 2);
+    BBB_CHECK(batch.empty());
+}
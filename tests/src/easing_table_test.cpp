@@ -0,0 +1,71 @@
+#include "test.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "bbb/view_system/easing_table.hpp"
+
+namespace {
+    template <typename f, typename g>
+    float maxDifference(const f &lhs, const g &rhs) {
+        float maxError = 0.0f;
+        for(int i = 0; i <= 10000; ++i) {
+            const float t = i / 10000.0f;
+            maxError = (std::max)(maxError, static_cast<float>(std::fabs(lhs(t) - rhs(t))));
+        }
+        return maxError;
+    }
+    
+    // max error of cubic_bezier against points on the curve, which are sampled by parameter directly
+    float bezierError(float x1, float y1, float x2, float y2) {
+        const bbb::easing::cubic_bezier bezier(x1, y1, x2, y2);
+        double maxError = 0.0;
+        for(int i = 0; i <= 10000; ++i) {
+            const double s = i / 10000.0, u = 1.0 - s;
+            const double x = 3.0 * u * u * s * x1 + 3.0 * u * s * s * x2 + s * s * s;
+            const double y = 3.0 * u * u * s * y1 + 3.0 * u * s * s * y2 + s * s * s;
+            maxError = (std::max)(maxError, std::fabs(bezier(static_cast<float>(x)) - y));
+        }
+        return static_cast<float>(maxError);
+    }
+};
+
+BBB_TEST(easing_table_error_bound) {
+    using namespace bbb::easing;
+    for(std::size_t k = 0; k <= static_cast<std::size_t>(type::circular_in_out); ++k) {
+        const type e = static_cast<type>(k);
+        // see comment of table
+        float bound = 1.0e-4f;
+        if(type::exponential_in <= e && e <= type::exponential_in_out) bound = 1.0e-3f;
+        if(type::circular_in <= e) bound = 2.5e-2f;
+        const float error = maxDifference(table::of(e), [e](float t) { return evaluate(e, t); });
+        if(!BBB_CHECK(error < bound)) std::printf("  type %zu: max error %g\n", k, error);
+    }
+    
+    const table lut(type::cubic_in_out, 16);
+    BBB_CHECK(lut(0.0f) == 0.0f && lut(1.0f) == 1.0f);
+    BBB_CHECK(lut(-1.0f) == 0.0f && lut(2.0f) == 1.0f);
+}
+
+BBB_TEST(cubic_bezier_error_bound) {
+    using namespace bbb::easing;
+    // css ease, ease-in, ease-out, ease-in-out, overshooting one
+    BBB_CHECK(bezierError(0.25f, 0.1f, 0.25f, 1.0f) < 1.0e-4f);
+    BBB_CHECK(bezierError(0.42f, 0.0f, 1.0f, 1.0f) < 1.0e-4f);
+    BBB_CHECK(bezierError(0.0f, 0.0f, 0.58f, 1.0f) < 1.0e-4f);
+    BBB_CHECK(bezierError(0.42f, 0.0f, 0.58f, 1.0f) < 1.0e-4f);
+    BBB_CHECK(bezierError(0.3f, -0.5f, 0.7f, 1.5f) < 1.0e-4f);
+    // nearly flat x at middle, where Newton's method falls back to bisection
+    BBB_CHECK(bezierError(0.9f, 0.0f, 0.1f, 1.0f) < 1.0e-4f);
+    // vertical tangent at middle. error of x by float is magnified there
+    BBB_CHECK(bezierError(1.0f, 0.0f, 0.0f, 1.0f) < 2.0e-2f);
+    
+    const cubic_bezier linear(0.0f, 0.0f, 1.0f, 1.0f);
+    BBB_CHECK(maxDifference(linear, [](float t) { return t; }) < 1.0e-5f);
+    
+    // table of bezier
+    const cubic_bezier ease(0.25f, 0.1f, 0.25f, 1.0f);
+    BBB_CHECK(maxDifference(table(ease), ease) < 1.0e-4f);
+    const cubic_bezier steep(0.9f, 0.0f, 0.1f, 1.0f);
+    BBB_CHECK(maxDifference(table(steep), steep) < 1.0e-3f);
+}
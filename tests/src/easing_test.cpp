@@ -0,0 +1,72 @@
+#include "test.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "bbb/view_system/easing.hpp"
+
+namespace {
+    // odd size to test both of SIMD lanes and scalar tail
+    std::vector<float> progresses(std::size_t n) {
+        std::vector<float> t(n);
+        for(std::size_t i = 0; i < n; ++i) t[i] = i / static_cast<float>(n - 1);
+        return t;
+    }
+};
+
+BBB_TEST(easing_array_matches_scalar) {
+    using namespace bbb::easing;
+    const std::vector<float> t = progresses(1037);
+    std::vector<float> result(t.size() + 1);
+    for(std::size_t k = 0; k <= static_cast<std::size_t>(type::circular_in_out); ++k) {
+        const type e = static_cast<type>(k);
+        // unaligned output
+        evaluate(e, t.data(), result.data() + 1, t.size());
+        float maxError = 0.0f;
+        bool isFinite = true;
+        for(std::size_t i = 0; i < t.size(); ++i) {
+            isFinite = isFinite && std::isfinite(result[i + 1]);
+            maxError = (std::max)(maxError, std::fabs(result[i + 1] - evaluate(e, t[i])));
+        }
+        if(!BBB_CHECK(isFinite && maxError < 1.0e-5f)) std::printf("  type %zu: max error %g\n", k, maxError);
+    }
+}
+
+BBB_TEST(easing_in_out_curves) {
+    using namespace bbb::easing;
+    const std::vector<float> t = progresses(1001);
+    std::vector<float> simd(t.size());
+    
+    // f(t) = 16t^5 for t < 0.5, 1 - (2 - 2t)^5 / 2 otherwise
+    quintic::in_out(t.data(), simd.data(), t.size());
+    float maxError = 0.0f;
+    for(std::size_t i = 0; i < t.size(); ++i) {
+        const double x = t[i];
+        const double expected = x < 0.5 ? 16.0 * std::pow(x, 5.0) : 1.0 - 0.5 * std::pow(2.0 - 2.0 * x, 5.0);
+        maxError = (std::max)(maxError, static_cast<float>(std::fabs(quintic::in_out(t[i]) - expected)));
+        maxError = (std::max)(maxError, static_cast<float>(std::fabs(simd[i] - expected)));
+    }
+    BBB_CHECK(maxError < 1.0e-5f);
+    BBB_CHECK(quintic::in_out(0.0f) == 0.0f && quintic::in_out(0.5f) == 0.5f && quintic::in_out(1.0f) == 1.0f);
+    
+    // f(t) = (1 - sqrt(1 - 4t^2)) / 2 for t < 0.5, (1 + sqrt(1 - (2 - 2t)^2)) / 2 otherwise
+    circular::in_out(t.data(), simd.data(), t.size());
+    maxError = 0.0f;
+    for(std::size_t i = 0; i < t.size(); ++i) {
+        const double x = t[i];
+        const double expected = x < 0.5
+            ? 0.5 * (1.0 - std::sqrt(1.0 - 4.0 * x * x))
+            : 0.5 * (1.0 + std::sqrt(1.0 - (2.0 - 2.0 * x) * (2.0 - 2.0 * x)));
+        maxError = (std::max)(maxError, static_cast<float>(std::fabs(circular::in_out(t[i]) - expected)));
+        maxError = (std::max)(maxError, static_cast<float>(std::fabs(simd[i] - expected)));
+    }
+    BBB_CHECK(maxError < 1.0e-5f);
+    BBB_CHECK(circular::in_out(0.0f) == 0.0f && circular::in_out(0.5f) == 0.5f && circular::in_out(1.0f) == 1.0f);
+    
+    // point symmetric around (0.5, 0.5)
+    for(float x : {0.1f, 0.25f, 0.4f}) {
+        BBB_CHECK(std::fabs(quintic::in_out(x) + quintic::in_out(1.0f - x) - 1.0f) < 1.0e-6f);
+        BBB_CHECK(std::fabs(circular::in_out(x) + circular::in_out(1.0f - x) - 1.0f) < 1.0e-6f);
+    }
+}
@@ -0,0 +1,138 @@
+#include "test.hpp"
+
+#include <string>
+
+#include "bbb/view_system/components/view.hpp"
+
+BBB_TEST(event_router_view_destructed_by_callback) {
+    using namespace bbb::vs;
+    auto &&router = event_router::get();
+    auto root = view::create(0, 0, 400, 400);
+    auto a = view::create(10, 10, 100, 100);
+    auto front = view::create(10, 10, 100, 100); // hit before a, but transparent
+    front->setEventTransparentness(true);
+    root->add(a);
+    root->add(front);
+    root->registerEvents();
+    
+    std::string log;
+    root->onMouseCapture([&](mouse_event_arg arg) {
+        if(arg.type != mouse_event_type::down) return;
+        log += "c";
+        front->removeFromParent();
+        front.reset();
+    });
+    a->onClickDown([&log] { log += "a"; });
+    router.dispatchMouse(mouse_event_type::down, {20, 20});
+    BBB_CHECK(a->hasPointerCapture());
+    router.dispatchMouse(mouse_event_type::up, {20, 20});
+    BBB_CHECK(log == "ca");
+    
+    root->unregisterEvents();
+}
+
+BBB_TEST(event_router_nested_dispatch_is_deferred) {
+    using namespace bbb::vs;
+    auto &&router = event_router::get();
+    auto root = view::create(0, 0, 400, 400);
+    auto a = view::create(10, 10, 100, 100);
+    root->add(a);
+    root->registerEvents();
+    
+    std::string log;
+    a->onTouchDown([&] {
+        log += "t";
+        router.dispatchMouse(mouse_event_type::down, {20, 20});
+        log += "T";
+    });
+    a->onClickDown([&] {
+        log += "d";
+        router.dispatchMouse(mouse_event_type::up, {20, 20});
+        router.flushTouches();
+        router.setCoalescing(true);
+        router.postMouse(mouse_event_type::over, {30, 30});
+        router.setCoalescing(false);
+        log += "D";
+    });
+    a->onClickUp([&log] { log += "u"; });
+    a->onMouseOver([&log] { log += "o"; });
+    router.postTouch(touch_event_type::down, 1, {20, 20});
+    router.postTouch(touch_event_type::up, 1, {20, 20});
+    router.flushTouches();
+    BBB_CHECK(log == "tTdDuo");
+    
+    root->unregisterEvents();
+}
+
+BBB_TEST(event_router_view_at_address_of_destructed_one_is_skipped) {
+    using namespace bbb::vs;
+    auto &&router = event_router::get();
+    // freed block of arena is reused first, so new view gets address of destructed one
+    auto screenArena = arena::create();
+    scoped_arena scope(screenArena);
+    auto root = view::create(0, 0, 400, 400);
+    auto back = view::create(10, 10, 100, 100);
+    auto front = view::create(10, 10, 100, 100);
+    front->setEventTransparentness(true);
+    root->add(back);
+    root->add(front);
+    root->registerEvents();
+    
+    std::string log;
+    const view *address = back.get();
+    view::ref fresh;
+    front->onClickDown([&] {
+        log += "f";
+        back->removeFromParent();
+        back.reset();
+        fresh = view::create(10, 10, 100, 100);
+        fresh->onClickDown([&log] { log += "x"; });
+        fresh->onMouseCapture([&log] { log += "c"; });
+    });
+    router.dispatchMouse(mouse_event_type::down, {20, 20});
+    router.dispatchMouse(mouse_event_type::up, {20, 20});
+    BBB_CHECK(fresh.get() == address);
+    BBB_CHECK(log == "f");
+    
+    root->unregisterEvents();
+}
+
+BBB_TEST(event_router_hover_is_kept_while_far_view_moves) {
+    using namespace bbb::vs;
+    auto &&router = event_router::get();
+    auto root = view::create(0, 0, 400, 400);
+    auto a = view::create(10, 10, 100, 100);
+    auto far = view::create(300, 300, 50, 50);
+    auto b = view::create(200, 10, 50, 50);
+    root->add(a);
+    root->add(far);
+    root->add(b);
+    root->registerEvents();
+    
+    std::string log;
+    a->onMouseEnter([&log] { log += "A"; });
+    a->onMouseLeave([&log] { log += "a"; });
+    b->onMouseEnter([&log] { log += "B"; });
+    b->onMouseLeave([&log] { log += "b"; });
+    router.dispatchMouse(mouse_event_type::over, {20, 20});
+    BBB_CHECK(log == "A");
+    
+    // moves out of hovered area don't invalidate hit-testing globally
+    const std::uint64_t generation = view::hitTestGeneration();
+    far->setPosition(310, 300);
+    root->setSize(500, 500);
+    BBB_CHECK(view::hitTestGeneration() == generation);
+    router.dispatchMouse(mouse_event_type::over, {21, 20});
+    BBB_CHECK(log == "A");
+    BBB_CHECK(view::frameChangedViews().empty());
+    
+    // but views moved into it, or hovered views moved away are refreshed
+    b->setPosition(15, 15);
+    router.dispatchMouse(mouse_event_type::over, {22, 20});
+    BBB_CHECK(log == "AB");
+    a->setPosition(200, 200);
+    router.dispatchMouse(mouse_event_type::over, {23, 20});
+    BBB_CHECK(log == "ABa");
+    
+    root->unregisterEvents();
+}
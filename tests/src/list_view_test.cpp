@@ -0,0 +1,84 @@
+#include "test.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "bbb/view_system/components/list_view.hpp"
+
+BBB_TEST(list_view_scrolling_with_user_callbacks) {
+    using namespace bbb::vs;
+    auto &&manager = animation::manager::get();
+    manager.setClockMode(animation::clock_mode::manual);
+    auto &&router = event_router::get();
+    auto root = view::create(0, 0, 800, 800);
+    auto list = list_view::create(0, 0, 300, 600);
+    list->setRowHeight(50);
+    list->setNumberOfRows(1000);
+    list->setMomentumEnabled(false);
+    root->add(list);
+    root->registerEvents();
+    
+    // callbacks of scroll_view are for users
+    int numDrags = 0, numUps = 0;
+    list->onMouseCapture([] {});
+    list->onClickDown([] {});
+    list->onDrag([&numDrags] { ++numDrags; });
+    list->onClickUp([&numUps] { ++numUps; });
+    list->onTouchDown([] {});
+    list->onTouchMove([] {});
+    list->onTouchUp([] {});
+    router.dispatchMouse(mouse_event_type::down, {100, 300});
+    router.dispatchMouse(mouse_event_type::drag, {100, 250});
+    router.dispatchMouse(mouse_event_type::up, {100, 250});
+    BBB_CHECK(list->getContentOffset().y == 50.0f);
+    BBB_CHECK(numDrags == 1 && numUps == 1);
+    
+    // only the touch which started dragging scrolls
+    router.postTouch(touch_event_type::down, 1, {100, 300});
+    router.postTouch(touch_event_type::down, 2, {200, 300});
+    router.postTouch(touch_event_type::move, 1, {100, 280});
+    router.postTouch(touch_event_type::move, 2, {200, 100});
+    router.postTouch(touch_event_type::up, 2, {200, 100});
+    router.postTouch(touch_event_type::move, 1, {100, 270});
+    router.flushTouches();
+    BBB_CHECK(list->getContentOffset().y == 80.0f);
+    BBB_CHECK(list->isScrolling());
+    router.postTouch(touch_event_type::up, 1, {100, 270});
+    router.flushTouches();
+    BBB_CHECK(!list->isScrolling());
+    
+    root->unregisterEvents();
+}
+
+BBB_TEST(list_view_follows_width_and_cell_factory) {
+    using namespace bbb::vs;
+    auto list = list_view::create(0, 0, 300, 600);
+    list->setRowHeight(50);
+    list->setNumberOfRows(1000);
+    
+    // content shrinks with list, so it can't be scrolled horizontally
+    list->setSize(200, 600);
+    list->draw(ofRectangle(0, 0, 800, 800));
+    BBB_CHECK(list->getContentSize().x == 200.0f);
+    BBB_CHECK(list->getMaxContentOffset().x == 0.0f);
+    BBB_CHECK(list->getCell(0)->getFrame().width == 200.0f);
+    
+    // cells made by previous factory are not reused
+    std::vector<std::weak_ptr<view>> previousCells;
+    for(std::size_t row = 0; row < list->getNumVisibleCells(); ++row) previousCells.push_back(list->getCell(row));
+    // fewer rows are visible, so some cells are pooled
+    list->setSize(200, 300);
+    list->draw(ofRectangle(0, 0, 800, 800));
+    BBB_CHECK(0 < list->getNumPooledCells());
+    std::vector<view *> created;
+    list->onCreateCell([&created] {
+        auto cell = view::create(ofRectangle());
+        created.push_back(cell.get());
+        return cell;
+    });
+    BBB_CHECK(list->getNumPooledCells() == 0);
+    BBB_CHECK(std::find(created.begin(), created.end(), list->getCell(0).get()) != created.end());
+    bool isReleased = true;
+    for(auto &&cell : previousCells) isReleased = isReleased && cell.expired();
+    BBB_CHECK(isReleased);
+}
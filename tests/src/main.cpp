@@ -0,0 +1,10 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+
+#include "test.hpp"
+
+// headless. tests are run without main loop, so they flush events and step animations by themselves.
+int main() {
+    ofSetupOpenGL(std::make_shared<ofAppNoWindow>(), 1024, 768, OF_WINDOW);
+    return bbb::test::run();
+}
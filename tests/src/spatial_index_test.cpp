@@ -0,0 +1,57 @@
+#include "test.hpp"
+
+#include <memory>
+#include <vector>
+
+#include "bbb/view_system/components/view.hpp"
+
+BBB_TEST(spatial_index_removed_view_is_not_indexed_again) {
+    using namespace bbb::vs;
+    auto root = view::create(0, 0, 400, 400);
+    root->enableSpatialIndex();
+    auto child = view::create(10, 10, 50, 50);
+    root->add("child", child);
+    root->remove("child");
+    BBB_CHECK(!child->getParent());
+    
+    // moving removed view doesn't touch index of old parent
+    child->setPosition(20, 20);
+    BBB_CHECK(child->convertToGlobalCoordinate() == ofPoint(20, 20));
+    std::vector<view *> hits;
+    root->collectHits({30, 30}, hits);
+    BBB_CHECK(hits.size() == 1 && hits[0] == root.get());
+    
+    // and destroying it leaves nothing behind
+    child->setPosition(30, 30);
+    std::weak_ptr<view> weak = child;
+    child.reset();
+    BBB_CHECK(weak.expired());
+    hits.clear();
+    root->collectHits({40, 40}, hits);
+    BBB_CHECK(hits.size() == 1 && hits[0] == root.get());
+}
+
+BBB_TEST(spatial_index_keeps_hits_of_descendants_out_of_subview) {
+    using namespace bbb::vs;
+    auto root = view::create(0, 0, 400, 400);
+    auto child = view::create(0, 0, 10, 10);
+    auto grandchild = view::create(200, 200, 20, 20);
+    root->add(child);
+    child->add(grandchild);
+    
+    std::vector<view *> withoutIndex, withIndex;
+    root->collectHits({210, 210}, withoutIndex);
+    root->enableSpatialIndex();
+    root->collectHits({210, 210}, withIndex);
+    BBB_CHECK(!withoutIndex.empty() && withoutIndex[0] == grandchild.get());
+    BBB_CHECK(withIndex == withoutIndex);
+    
+    // moving descendant refreshes entry of subview
+    grandchild->setPosition(300, 100);
+    withIndex.clear();
+    root->collectHits({310, 110}, withIndex);
+    BBB_CHECK(!withIndex.empty() && withIndex[0] == grandchild.get());
+    withIndex.clear();
+    root->collectHits({210, 210}, withIndex);
+    BBB_CHECK(withIndex.size() == 1 && withIndex[0] == root.get());
+}
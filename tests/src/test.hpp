@@ -0,0 +1,69 @@
+//
+//  test.hpp
+//
+//  Created by ISHII 2bit on 2018/03/25.
+//
+
+#pragma once
+
+#ifndef bbb_view_system_test_hpp
+#define bbb_view_system_test_hpp
+
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+namespace bbb {
+    namespace test {
+        struct entry {
+            const char *name;
+            void (*run)();
+        };
+        
+        inline std::vector<entry> &entries() {
+            static std::vector<entry> _;
+            return _;
+        }
+        inline std::size_t &numFailures() {
+            static std::size_t _{0};
+            return _;
+        }
+        
+        // defined in allocation_counter.cpp. counts operator new of whole program.
+        std::size_t numAllocations();
+        
+        // BBB_TEST registers function by static instance of this, so each test file has no declaration in main.
+        struct registration {
+            registration(const char *name, void (*run)()) { entries().push_back({name, run}); };
+        };
+        
+        inline bool check(bool condition, const char *expression, const char *file, int line) {
+            if(!condition) {
+                ++numFailures();
+                std::printf("  FAILED: %s (%s:%d)\n", expression, file, line);
+            }
+            return condition;
+        }
+        
+        // runs all registered tests. returns 1 if any check failed, for exit code
+        inline int run() {
+            for(auto &&e : entries()) {
+                const std::size_t before = numFailures();
+                std::printf("[%s]\n", e.name);
+                e.run();
+                std::printf("  %s\n", numFailures() == before ? "ok" : "failed");
+            }
+            std::printf("%zu tests, %zu failures\n", entries().size(), numFailures());
+            return numFailures() == 0 ? 0 : 1;
+        }
+    };
+};
+
+#define BBB_TEST(name) \
+    static void name(); \
+    static bbb::test::registration name##_registration(#name, name); \
+    static void name()
+
+#define BBB_CHECK(...) bbb::test::check((__VA_ARGS__), #__VA_ARGS__, __FILE__, __LINE__)
+
+#endif /* bbb_view_system_test_hpp */
@@ -0,0 +1,148 @@
+#include "test.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bbb/view_system/components/view.hpp"
+
+namespace {
+    using namespace bbb::vs;
+    
+    // front-most view which is not event transparent, by single point hit-test
+    view *targetOf(const std::vector<view::ref> &roots, const ofPoint &p) {
+        std::vector<view *> hits;
+        for(auto &&root : roots) if(root->collectHits(p, hits)) break;
+        for(auto &&v : hits) if(!v->isEventTransparent()) return v;
+        return nullptr;
+    }
+    
+    void addRandomSubviews(const view::ref &parent, std::mt19937 &random, int depth) {
+        std::uniform_real_distribution<float> position(-20.0f, 180.0f), size(10.0f, 120.0f), chance(0.0f, 1.0f);
+        for(int i = 0; i < 4; ++i) {
+            auto v = view::create(position(random), position(random), size(random), size(random));
+            if(chance(random) < 0.2f) v->setEventTransparentness(true);
+            if(chance(random) < 0.1f) v->disableUserInteraction();
+            if(chance(random) < 0.2f) v->setClipSubviews(true);
+            if(chance(random) < 0.1f) v->hide();
+            parent->add(v);
+            if(0 < depth) addRandomSubviews(v, random, depth - 1);
+        }
+    }
+};
+
+BBB_TEST(touch_stream_in_one_flush) {
+    auto &&router = event_router::get();
+    auto root = view::create(0, 0, 400, 400);
+    auto a = view::create(10, 10, 100, 100);
+    auto b = view::create(200, 10, 100, 100);
+    auto cover = view::create(0, 0, 400, 400); // in front of a and b, but transparent
+    cover->setEventTransparentness(true);
+    root->add(a);
+    root->add(b);
+    root->add(cover);
+    root->registerEvents();
+    
+    std::string log;
+    auto record = [&log](char name) {
+        return [&log, name](touch_event_arg arg) {
+            const char types[] = {'d', 'm', 'u'};
+            log += name;
+            log += types[static_cast<int>(arg.type)];
+            log += std::to_string(arg.id);
+            if(arg.phase == event_phase::bubble) log += '^';
+            log += ' ';
+        };
+    };
+    for(auto &&v : {a, b, root}) {
+        const char name = v == a ? 'a' : v == b ? 'b' : 'r';
+        v->onTouchDown(record(name));
+        v->onTouchMove(record(name));
+        v->onTouchUp(record(name));
+    }
+    
+    // down, move and up of same id in one flush. move goes to target of down even if it is outside.
+    router.postTouch(touch_event_type::down, 1, {20, 20});
+    router.postTouch(touch_event_type::down, 2, {250, 20});
+    router.postTouch(touch_event_type::move, 1, {350, 20});
+    router.postTouch(touch_event_type::up, 1, {350, 20});
+    BBB_CHECK(log.empty());
+    router.flushTouches();
+    BBB_CHECK(log == "ad1 rd1^ bd2 rd2^ am1 rm1^ au1 ru1^ ");
+    BBB_CHECK(a->getNumTouches() == 0 && b->getNumTouches() == 1 && router.getNumTouches() == 1);
+    
+    // down again without up of id 2, e.g. lost up
+    log.clear();
+    router.postTouch(touch_event_type::down, 2, {20, 20});
+    router.flushTouches();
+    BBB_CHECK(log == "ad2 rd2^ ");
+    BBB_CHECK(a->getNumTouches() == 1 && b->getNumTouches() == 0);
+    
+    // successive moves are merged with coalescing, and delta is movement from last dispatched point
+    log.clear();
+    ofPoint delta;
+    a->onTouchMove([&delta](touch_event_arg arg) { delta = arg.delta; });
+    router.setCoalescing(true);
+    router.postTouch(touch_event_type::move, 2, {30, 20});
+    router.postTouch(touch_event_type::move, 2, {40, 25});
+    router.postTouch(touch_event_type::up, 2, {40, 25});
+    router.flushTouches();
+    router.setCoalescing(false);
+    BBB_CHECK(delta == ofPoint(20, 5));
+    BBB_CHECK(log == "rm2^ au2 ru2^ ");
+    BBB_CHECK(router.getNumTouches() == 0 && a->getNumTouches() == 0);
+    
+    // up of unknown id is ignored
+    log.clear();
+    router.postTouch(touch_event_type::up, 7, {20, 20});
+    router.flushTouches();
+    BBB_CHECK(log.empty());
+    
+    root->unregisterEvents();
+}
+
+BBB_TEST(touch_targets_match_single_point_hit_test) {
+    auto &&router = event_router::get();
+    std::mt19937 random(1);
+    std::vector<view::ref> roots;
+    for(int i = 0; i < 2; ++i) {
+        roots.push_back(view::create(0, 0, 400, 400));
+        roots.back()->setEventTransparentness(true);
+        addRandomSubviews(roots.back(), random, 3);
+        roots.back()->registerEvents();
+    }
+    
+    // 40 fingers
+    std::uniform_real_distribution<float> coordinate(-10.0f, 300.0f);
+    std::vector<ofPoint> points;
+    for(int i = 0; i < 40; ++i) points.emplace_back(coordinate(random), coordinate(random));
+    std::vector<view *> expected;
+    for(auto &&p : points) expected.push_back(targetOf(roots, p));
+    
+    std::vector<view *> targets(points.size(), nullptr);
+    std::vector<std::size_t> pending;
+    for(std::size_t i = 0; i < points.size(); ++i) pending.push_back(i);
+    for(auto &&root : roots) root->findTargets(points, targets, pending, 0, points.size());
+    std::size_t numMismatches = 0, numHits = 0;
+    for(std::size_t i = 0; i < points.size(); ++i) {
+        if(targets[i] != expected[i]) ++numMismatches;
+        if(expected[i]) ++numHits;
+    }
+    std::printf("  %zu of %zu points hit\n", numHits, points.size());
+    BBB_CHECK(numMismatches == 0);
+    
+    // downs dispatched by router reach same targets
+    std::vector<view *> received(points.size(), nullptr);
+    for(std::size_t i = 0; i < points.size(); ++i) {
+        if(targets[i]) targets[i]->onTouchDown([&received](touch_event_arg arg) {
+            if(arg.phase == event_phase::target) received[arg.id] = arg.target;
+        });
+    }
+    for(std::size_t i = 0; i < points.size(); ++i) router.postTouch(touch_event_type::down, static_cast<int>(i), points[i]);
+    for(std::size_t i = 0; i < points.size(); ++i) router.postTouch(touch_event_type::up, static_cast<int>(i), points[i]);
+    router.flushTouches();
+    BBB_CHECK(received == targets);
+    BBB_CHECK(router.getNumTouches() == 0);
+    
+    for(auto &&root : roots) root->unregisterEvents();
+}